@@ -0,0 +1,289 @@
+#!/usr/bin/env python3
+#
+# Copyright 2018, Intel Corporation
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in
+#       the documentation and/or other materials provided with the
+#       distribution.
+#
+#     * Neither the name of the copyright holder nor the names of its
+#       contributors may be used to endorse or promote products derived
+#       from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+'''Compare two sets of benchmark results written with --results_file and
+flag statistically significant regressions beyond given tolerance.'''
+
+import json
+import math
+import re
+import sys
+from argparse import ArgumentParser
+from collections import OrderedDict
+
+# exit code when any regression was found
+REGRESSION_EXIT_CODE = 1
+# exit code when results could not be read
+ERROR_EXIT_CODE = 2
+
+# metrics better when higher, others are better when lower
+HIGHER_IS_BETTER = re.compile(r'/s$')
+HIGHER_IS_BETTER_NAME = re.compile(r'(_ipc|bandwidth|throughput)$')
+
+
+def read_results(paths, include_failed):
+    '''Read results files into {(binary, workload, params, metric):
+    (unit, [values])} and collect PMDK versions and hosts they come from.'''
+    samples = OrderedDict()
+    versions = set()
+    hosts = set()
+
+    for file_path in paths:
+        try:
+            with open(file_path) as results:
+                lines = results.readlines()
+        except OSError as e:
+            print('Cannot read {}: {}'.format(file_path, e), file=sys.stderr)
+            sys.exit(ERROR_EXIT_CODE)
+
+        for number, line in enumerate(lines, 1):
+            if not line.strip():
+                continue
+            try:
+                result = json.loads(line)
+            except ValueError:
+                print('{}:{}: invalid result line'.format(file_path, number),
+                      file=sys.stderr)
+                sys.exit(ERROR_EXIT_CODE)
+
+            if not result.get('passed', False) and not include_failed:
+                continue
+
+            versions.add(result.get('pmdk_version', 'unknown'))
+            hosts.add(result.get('host', {}).get('hostname', 'unknown'))
+            for name, metric in result.get('metrics', {}).items():
+                key = (result.get('binary', ''), result.get('workload', ''),
+                       result.get('params', ''), name)
+                unit, values = samples.setdefault(
+                    key, (metric.get('unit', ''), []))
+                if metric.get('value') is not None:
+                    values.append(float(metric['value']))
+
+    return samples, versions, hosts
+
+
+def mean_stddev(values):
+    '''Return mean and sample standard deviation of values.'''
+    mean = sum(values) / len(values)
+    if len(values) < 2:
+        return mean, 0.0
+    variance = sum((v - mean) ** 2 for v in values) / (len(values) - 1)
+    return mean, math.sqrt(variance)
+
+
+def incomplete_beta(a, b, x):
+    '''Regularized incomplete beta function I_x(a, b), evaluated with
+    continued fraction (modified Lentz's method).'''
+    if x <= 0:
+        return 0.0
+    if x >= 1:
+        return 1.0
+    if x > (a + 1) / (a + b + 2):
+        return 1.0 - incomplete_beta(b, a, 1 - x)
+
+    front = math.exp(math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b) +
+                     a * math.log(x) + b * math.log(1 - x)) / a
+    tiny = 1e-300
+    f, c, d = 1.0, 1.0, 0.0
+    for i in range(200):
+        m = i // 2
+        if i == 0:
+            numerator = 1.0
+        elif i % 2 == 0:
+            numerator = m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m))
+        else:
+            numerator = -(a + m) * (a + b + m) * x / \
+                ((a + 2 * m) * (a + 2 * m + 1))
+        d = 1.0 + numerator * d
+        d = 1.0 / (d if abs(d) > tiny else tiny)
+        c = 1.0 + numerator / c
+        c = c if abs(c) > tiny else tiny
+        f *= c * d
+        if abs(1.0 - c * d) < 1e-12:
+            break
+
+    return front * (f - 1.0)
+
+
+def welch_p_value(baseline, candidate):
+    '''Return two-sided p-value of Welch's t-test of equal means, None if
+    either sample has fewer than two values.'''
+    if len(baseline) < 2 or len(candidate) < 2:
+        return None
+
+    mean_b, sd_b = mean_stddev(baseline)
+    mean_c, sd_c = mean_stddev(candidate)
+    var_b = sd_b ** 2 / len(baseline)
+    var_c = sd_c ** 2 / len(candidate)
+    if var_b + var_c == 0:
+        return 1.0 if mean_b == mean_c else 0.0
+
+    t = (mean_c - mean_b) / math.sqrt(var_b + var_c)
+    df = (var_b + var_c) ** 2 / (var_b ** 2 / (len(baseline) - 1) +
+                                 var_c ** 2 / (len(candidate) - 1))
+    return incomplete_beta(df / 2, 0.5, df / (df + t * t))
+
+
+def is_higher_better(name, unit):
+    '''Tell whether increase of metric is an improvement.'''
+    return bool(HIGHER_IS_BETTER.search(unit) or
+                HIGHER_IS_BETTER_NAME.search(name))
+
+
+def compare(baseline, candidate, tolerance, alpha):
+    '''Compare samples of metrics present in both sets. Return rows of
+    comparison and number of regressions.'''
+    rows = []
+    regressions = 0
+
+    for key, (unit, values_c) in candidate.items():
+        if key not in baseline:
+            rows.append((key, unit, None, values_c, None, None, 'new'))
+            continue
+        values_b = baseline[key][1]
+        if not values_b or not values_c:
+            rows.append((key, unit, values_b, values_c, None, None,
+                         'no values'))
+            continue
+
+        mean_b = mean_stddev(values_b)[0]
+        mean_c = mean_stddev(values_c)[0]
+        change = (mean_c - mean_b) / abs(mean_b) if mean_b != 0 else \
+            (0.0 if mean_c == 0 else math.copysign(math.inf, mean_c))
+        p_value = welch_p_value(values_b, values_c)
+        worse = change < 0 if is_higher_better(key[3], unit) else change > 0
+        significant = p_value is None or p_value < alpha
+
+        status = ''
+        if abs(change) > tolerance and significant:
+            if worse:
+                status = 'REGRESSION'
+                regressions += 1
+            else:
+                status = 'improvement'
+        rows.append((key, unit, values_b, values_c, change, p_value, status))
+
+    for key, (unit, values_b) in baseline.items():
+        if key not in candidate:
+            rows.append((key, unit, values_b, None, None, None, 'missing'))
+
+    return rows, regressions
+
+
+def format_sample(values):
+    '''Format mean, standard deviation and size of sample.'''
+    if not values:
+        return '-'
+    mean, stddev = mean_stddev(values)
+    return '{:.4g} +-{:.2g} (n={})'.format(mean, stddev, len(values))
+
+
+def print_rows(rows, show_all):
+    '''Print comparison table, only changed metrics unless show_all.'''
+    header = ('benchmark', 'metric', 'baseline', 'candidate', 'change',
+              'p-value', 'status')
+    table = [header]
+    for key, unit, values_b, values_c, change, p_value, status in rows:
+        if not status and not show_all:
+            continue
+        binary, workload, params, metric = key
+        name = '{}:{}'.format(binary, workload) if binary else workload
+        if params:
+            name += ' ' + (params if params.startswith('(') else
+                           '({})'.format(params))
+        table.append((name, '{} [{}]'.format(metric, unit) if unit else metric,
+                      format_sample(values_b), format_sample(values_c),
+                      '-' if change is None else '{:+.1%}'.format(change),
+                      'n/a' if p_value is None else '{:.3g}'.format(p_value),
+                      status))
+
+    if len(table) == 1:
+        print('No significant changes.')
+        return
+
+    widths = [max(len(row[i]) for row in table) for i in range(len(header))]
+    for row in table:
+        print('  '.join(cell.ljust(width)
+                        for cell, width in zip(row, widths)).rstrip())
+
+
+def parse_args():
+    '''Parse command line arguments.'''
+    parser = ArgumentParser(description='Compares benchmark results written '
+                            'by benchmark binaries with --results_file. '
+                            'Repeated results of the same benchmark (e.g. '
+                            'with --gtest_repeat) are samples of Welch\'s '
+                            't-test. Exits with code {} if any metric '
+                            'regressed.'.format(REGRESSION_EXIT_CODE))
+    parser.add_argument('-b', '--baseline', nargs='+', required=True,
+                        help='results files of the baseline, e.g. of the '
+                        'previous PMDK release')
+    parser.add_argument('-c', '--candidate', nargs='+', required=True,
+                        help='results files compared against the baseline')
+    parser.add_argument('-t', '--tolerance', type=float, default=0.05,
+                        help='relative change not considered regression '
+                        '(default: 0.05)')
+    parser.add_argument('-a', '--alpha', type=float, default=0.05,
+                        help='significance level of the test (default: '
+                        '0.05). Changes of metrics with single sample are '
+                        'judged by tolerance only')
+    parser.add_argument('--include-failed', action='store_true',
+                        help='include results of failed benchmarks')
+    parser.add_argument('--all', action='store_true',
+                        help='print also metrics that did not change')
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    baseline, versions_b, hosts_b = read_results(args.baseline,
+                                                 args.include_failed)
+    candidate, versions_c, hosts_c = read_results(args.candidate,
+                                                  args.include_failed)
+
+    print('Baseline PMDK: {}, candidate PMDK: {}'.format(
+        ', '.join(sorted(versions_b)) or '-',
+        ', '.join(sorted(versions_c)) or '-'))
+    if hosts_b != hosts_c:
+        print('Warning: results come from different hosts: {} vs {}'.format(
+            ', '.join(sorted(hosts_b)), ', '.join(sorted(hosts_c))))
+
+    rows, regressions = compare(baseline, candidate, args.tolerance,
+                                args.alpha)
+    print_rows(rows, args.all)
+    print('{} regression(s) beyond {:.1%} tolerance'.format(regressions,
+                                                           args.tolerance))
+    return REGRESSION_EXIT_CODE if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
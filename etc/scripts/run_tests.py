@@ -32,16 +32,27 @@
 
 
 import xml.etree.ElementTree as ET
+import heapq
+import json
+import re
 import sys
+import time
 from subprocess import check_output, TimeoutExpired, CalledProcessError, STDOUT
 from argparse import ArgumentParser
-from os import linesep, path
+from concurrent.futures import ThreadPoolExecutor, as_completed
+from os import environ, linesep, makedirs, path
 from shutil import rmtree
 from pathlib import Path
 
+# name of environment variable overriding testDir from config.xml
+TESTDIR_ENV = 'PMDK_TESTS_DIR'
 
-def get_testdir_from_xml(binary_path):
-    '''Acquire test directory from provided config.xml file.'''
+# finished test line, e.g. '[       OK ] Case.Test/0 (12 ms)'
+RESULT_LINE = re.compile(r'^\[\s+(OK|FAILED)\s+\] ([^ ,]+).*\((\d+) ms\)$')
+
+
+def get_workdir_from_xml(binary_path):
+    '''Acquire testDir element value from provided config.xml file.'''
     config_path = path.join(path.dirname(binary_path), 'config.xml')
     root = ET.parse(config_path).getroot()
     testdir_xpath = 'localConfiguration/testDir'
@@ -49,8 +60,12 @@ def get_testdir_from_xml(binary_path):
     if elem is None:
         sys.exit('config.xml file invalid.'
                  ' Element {}/{} not found.'.format(root.tag, testdir_xpath))
-    workdir = elem.text
-    return path.join(workdir, 'pmdk_tests')
+    return elem.text
+
+
+def get_testdir_from_xml(binary_path):
+    '''Acquire test directory from provided config.xml file.'''
+    return path.join(get_workdir_from_xml(binary_path), 'pmdk_tests')
 
 
 def gtest_filter_rest(last_ran_test, all_tests, excluded):
@@ -111,6 +126,289 @@ def get_all_tests_to_run(cmd):
     return all_tests
 
 
+def get_full_test_names(cmd):
+    '''Call --gtest_list_tests on test binary and get full names \
+    (TestCase.Test) of all tests to be run.'''
+    list_tests_out = check_output(cmd + ['--gtest_list_tests']).decode('utf-8')
+    tests = []
+    test_case = None
+    for line in list_tests_out.splitlines():
+        name = line.split('#')[0].strip()
+        if not name:
+            continue
+        if not line.startswith(' '):
+            test_case = name
+        elif test_case:
+            tests.append(test_case + name)
+
+    if not tests:
+        sys.exit('No tests to run from {}.'.format(" ".join(cmd)))
+
+    return tests
+
+
+def execute_single_test(binary, test, timeout):
+    '''Run single test in separate process. Return output, exit code and \
+    information whether the test terminated the process (or timed out).'''
+    cmd = [binary, '--gtest_filter={}'.format(test)]
+    try:
+        out = check_output(cmd, timeout=timeout, stderr=STDOUT).decode('utf-8')
+    except TimeoutExpired as e:
+        out = e.output.decode('utf-8') if e.output else ''
+        return out + linesep + 'Execution timed out.', 1, True
+    except CalledProcessError as e:
+        out = e.output.decode('utf-8')
+        return out, e.returncode, not get_fails(out)
+    return out, 0, False
+
+
+def execute_tests_concurrently(binary, testdir, excluded, timeout, jobs):
+    '''Run every test from binary in its own process, at most jobs processes \
+    at once. Tests work in separate subdirectories of test directory, so they \
+    do not interfere with each other. Termination or timeout of one test \
+    does not stop execution of the remaining ones.
+    '''
+    cmd = [binary, '--gtest_filter=-{}'.format(excluded)]\
+        if excluded else [binary]
+    all_tests = get_full_test_names(cmd)
+
+    failing_tests = []
+    terminating_tests = []
+
+    with ThreadPoolExecutor(max_workers=jobs) as executor:
+        futures = {executor.submit(execute_single_test, binary, test,
+                                   timeout): test for test in all_tests}
+        for future in as_completed(futures):
+            test = futures[future]
+            out, returncode, terminated = future.result()
+            print(out)
+            if terminated:
+                terminating_tests.append(test)
+            elif returncode != 0:
+                failing_tests.append(test)
+
+    rmtree(testdir, ignore_errors=True)
+
+    if failing_tests or terminating_tests:
+        print_summary(failing_tests + terminating_tests, terminating_tests,
+                      all_tests, binary)
+        return 1
+
+    return 0
+
+
+def read_timing_file(timing_file):
+    '''Read test durations (in seconds) from timing file written by test \
+    binary run with --timing_file argument (JSON object per line).'''
+    durations = {}
+    with open(timing_file) as f:
+        for line in f:
+            if line.strip():
+                timing = json.loads(line)
+                durations[timing['name']] = float(timing['wall_s'])
+    return durations
+
+
+def read_durations(reports):
+    '''Read test durations (in seconds) recorded in gtest XML reports or \
+    timing files of previous runs. Later reports override earlier ones.'''
+    durations = {}
+    for report in reports:
+        try:
+            with open(report) as f:
+                is_xml = f.read(1) == '<'
+            if not is_xml:
+                durations.update(read_timing_file(report))
+                continue
+            root = ET.parse(report).getroot()
+        except (OSError, ValueError, KeyError, ET.ParseError) as e:
+            print('Cannot read durations from {}: {}'.format(report, e))
+            continue
+        for case in root.iter('testcase'):
+            if case.get('time') is None:
+                continue
+            name = '{}.{}'.format(case.get('classname'), case.get('name'))
+            durations[name] = float(case.get('time'))
+    return durations
+
+
+def assign_shards(tests, durations, shards):
+    '''Assign tests to shards using longest-processing-time-first rule: \
+    tests sorted by decreasing duration are placed one by one on the least \
+    loaded shard. Tests without recorded duration are assumed to take as \
+    long as an average recorded test. Return list of shards (lists of tests) \
+    and expected duration of the longest shard.'''
+    known = [durations[test] for test in tests if test in durations]
+    default = sum(known) / len(known) if known else 1.0
+
+    loads = [(0.0, i) for i in range(shards)]
+    assigned = [[] for _ in range(shards)]
+    for test in sorted(tests, key=lambda t: durations.get(t, default),
+                       reverse=True):
+        load, i = heapq.heappop(loads)
+        assigned[i].append(test)
+        heapq.heappush(loads, (load + durations.get(test, default), i))
+
+    return [shard for shard in assigned if shard], max(loads)[0]
+
+
+def get_results(output):
+    '''Get status and duration in seconds of every finished test from test \
+    binary execution output.'''
+    results = {}
+    for line in output.splitlines():
+        match = RESULT_LINE.match(line.strip())
+        if match:
+            status = 'passed' if match.group(1) == 'OK' else 'failed'
+            results[match.group(2)] = (status, int(match.group(3)) / 1000)
+    return results
+
+
+def get_last_ran_full_name(output):
+    '''Get full name of last executed test from test binary output.'''
+    for line in reversed(output.splitlines()):
+        if '[ RUN      ]' in line:
+            return line.replace('[ RUN      ]', '').strip()
+    return None
+
+
+def record_terminated(results, out, remaining, elapsed, durations):
+    '''Record tests which did not finish in single execution of the binary \
+    as terminated. The test running at the moment of termination is given \
+    time elapsed since the binary started minus durations of tests finished \
+    before it. Tests never started keep duration of the previous run (None \
+    if unknown), so they are not scheduled as instant ones next time.'''
+    finished = get_results(out)
+    results.update(finished)
+    last_ran_test = get_last_ran_full_name(out)
+    if last_ran_test in remaining and last_ran_test not in results:
+        spent = elapsed - sum(duration for _, duration in finished.values())
+        results[last_ran_test] = ('terminated', max(spent, 0.0))
+    for test in remaining:
+        results.setdefault(test, ('terminated', durations.get(test)))
+
+
+def execute_shard(binary, tests, shard_dir, timeout, durations):
+    '''Run tests assigned to shard in test directory of the shard. Resume \
+    execution omitting already ran tests after termination of the binary \
+    until all tests are run or timeout of the shard occurs. Return output \
+    and results of all tests of the shard.'''
+    makedirs(shard_dir, exist_ok=True)
+    env = dict(environ)
+    env[TESTDIR_ENV] = shard_dir
+    deadline = time.monotonic() + timeout if timeout else None
+
+    output = ''
+    results = {}
+    remaining = list(tests)
+    while remaining:
+        start = time.monotonic()
+        left = deadline - start if deadline else None
+        cmd = [binary, '--gtest_filter={}'.format(':'.join(remaining))]
+        try:
+            if left is not None and left <= 0:
+                raise TimeoutExpired(cmd, timeout)
+            out = check_output(cmd, timeout=left, stderr=STDOUT, env=env)
+            out = out.decode('utf-8')
+        except TimeoutExpired as e:
+            out = e.output.decode('utf-8') if e.output else ''
+            output += out + linesep + 'Execution of shard timed out.'
+            record_terminated(results, out, remaining,
+                              time.monotonic() - start, durations)
+            break
+        except CalledProcessError as e:
+            out = e.output.decode('utf-8')
+
+        output += out
+        results.update(get_results(out))
+        last_ran_test = get_last_ran_full_name(out)
+        if last_ran_test in remaining and last_ran_test not in results:
+            # binary terminated during the last started test, the rest of
+            # remaining tests is run by the next execution
+            record_terminated(results, out, [last_ran_test],
+                              time.monotonic() - start, durations)
+        elif any(test not in results for test in remaining):
+            # binary ended without reaching remaining tests
+            record_terminated(results, out, remaining,
+                              time.monotonic() - start, durations)
+        remaining = [test for test in remaining if test not in results]
+
+    rmtree(shard_dir, ignore_errors=True)
+    return output, results
+
+
+def write_report(report, results, elapsed):
+    '''Write results of all tests as single gtest XML report. The report may \
+    be used as source of durations for the next run, so tests with unknown \
+    duration are written without time attribute.'''
+    suites = {}
+    for test, (status, duration) in sorted(results.items()):
+        suite, name = test.split('.', 1)
+        suites.setdefault(suite, []).append((name, status, duration))
+
+    failures = sum(1 for status, _ in results.values() if status != 'passed')
+    root = ET.Element('testsuites', name='AllTests', tests=str(len(results)),
+                      failures=str(failures), errors='0',
+                      time='{:.3f}'.format(elapsed))
+    for suite, cases in suites.items():
+        suite_elem = ET.SubElement(
+            root, 'testsuite', name=suite, tests=str(len(cases)),
+            failures=str(sum(1 for c in cases if c[1] != 'passed')),
+            errors='0',
+            time='{:.3f}'.format(sum(c[2] for c in cases if c[2] is not None)))
+        for name, status, duration in cases:
+            case_elem = ET.SubElement(
+                suite_elem, 'testcase', name=name, status='run',
+                classname=suite)
+            if duration is not None:
+                case_elem.set('time', '{:.3f}'.format(duration))
+            if status != 'passed':
+                ET.SubElement(case_elem, 'failure', message=status)
+
+    ET.ElementTree(root).write(report, encoding='UTF-8', xml_declaration=True)
+
+
+def execute_sharded(binary, excluded, timeout, shards, durations_reports,
+                    report):
+    '''Split tests from binary into shards balanced by recorded durations \
+    and run shards concurrently, each in separate process with its own test \
+    directory. Merge results of all shards into single report.'''
+    cmd = [binary, '--gtest_filter=-{}'.format(excluded)]\
+        if excluded else [binary]
+    all_tests = get_full_test_names(cmd)
+    durations = read_durations(durations_reports)
+    assigned, expected = assign_shards(all_tests, durations, shards)
+    print('Running {} tests in {} shards, expected time: {:.1f} s'
+          .format(len(all_tests), len(assigned), expected))
+
+    workdir = get_workdir_from_xml(binary)
+    results = {}
+    start = time.monotonic()
+    with ThreadPoolExecutor(max_workers=len(assigned)) as executor:
+        futures = [executor.submit(
+            execute_shard, binary, tests,
+            path.join(workdir, 'pmdk_tests_shard{}'.format(i)), timeout,
+            durations)
+            for i, tests in enumerate(assigned)]
+        for future in as_completed(futures):
+            out, shard_results = future.result()
+            print(out)
+            results.update(shard_results)
+    elapsed = time.monotonic() - start
+
+    write_report(report, results, elapsed)
+    print('Finished in {:.1f} s, report written to {}'.format(elapsed, report))
+
+    failed = [t for t, (status, _) in results.items() if status != 'passed']
+    terminated = [t for t, (status, _) in results.items()
+                  if status == 'terminated']
+    if failed:
+        print_summary(sorted(failed), sorted(terminated), all_tests, binary)
+        return 1
+
+    return 0
+
+
 def last_test_terminated(out, returncode):
     """Last executed test terminated if in unsuccessful execution the last \
     '[ RUN     ]' doesn't have corresponding '[  FAILED  ]' afterwards.
@@ -187,6 +485,27 @@ if __name__ == '__main__':
     parser.add_argument(
         '-e', '--exclude', help='Tests to be excluded from'
                                 ' execution (using gtest_filter semantics)')
+    concurrency = parser.add_mutually_exclusive_group()
+    concurrency.add_argument(
+        '-j', '--jobs', help='Number of tests run concurrently, each in'
+                             ' separate process. Timeout applies to every'
+                             ' test separately. Default: 1 (whole binary is'
+                             ' run sequentially).', type=int, default=1)
+    concurrency.add_argument(
+        '-s', '--shards', help='Number of shards run concurrently. Tests are'
+                               ' assigned to shards by recorded durations,'
+                               ' each shard runs in its own test directory.'
+                               ' Timeout applies to every shard separately.',
+        type=int, default=0)
+    parser.add_argument(
+        '--durations', nargs='*', help='gtest XML reports or timing files'
+                                       ' (--timing_file argument of test'
+                                       ' binary) of previous runs to take'
+                                       ' test durations from.'
+                                       ' Default: report of sharded run.')
+    parser.add_argument(
+        '-r', '--report', help='Path of merged report of sharded run.'
+                               ' Default: <binary>_report.xml.')
 
     args = parser.parse_args()
 
@@ -197,7 +516,18 @@ if __name__ == '__main__':
 
     testdir = get_testdir_from_xml(args.gtest_binary)
 
-    exit_code = execute_all_tests(
-        args.gtest_binary, testdir, args.exclude, timeout)
+    if args.shards > 0:
+        report = args.report or args.gtest_binary + '_report.xml'
+        durations = args.durations
+        if durations is None:
+            durations = [report] if path.isfile(report) else []
+        exit_code = execute_sharded(args.gtest_binary, args.exclude, timeout,
+                                    args.shards, durations, report)
+    elif args.jobs > 1:
+        exit_code = execute_tests_concurrently(
+            args.gtest_binary, testdir, args.exclude, timeout, args.jobs)
+    else:
+        exit_code = execute_all_tests(
+            args.gtest_binary, testdir, args.exclude, timeout)
 
     sys.exit(exit_code)
@@ -0,0 +1,198 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "replication.h"
+#include <algorithm>
+#include <cstring>
+#include "api_c/api_c.h"
+
+double ReplicationAmplification::baseline_throughput_ = 0;
+
+int ReplicationAmplification::GetMountDirs(unsigned replicas,
+                                           ReplicaPlacement placement) {
+  std::string non_pmem_dir = local_dimm_config->GetTestDir();
+  unsigned namespaces = 0;
+
+  mount_dirs_.clear();
+  for (unsigned i = 0; i <= replicas; ++i) {
+    if (i > 0 && (placement == ReplicaPlacement::non_pmem ||
+                  (placement == ReplicaPlacement::mixed && i % 2 == 0))) {
+      mount_dirs_.emplace_back(non_pmem_dir);
+      continue;
+    }
+
+    if (local_dimm_config->GetSize() <= namespaces) {
+      std::cout << "Not enough namespaces configured, benchmark skipped"
+                << std::endl;
+      return -1;
+    }
+    mount_dirs_.emplace_back((*local_dimm_config)[namespaces++].GetTestDir());
+  }
+
+  return 0;
+}
+
+int ReplicationAmplification::BuildPoolset(const std::string &name) {
+  if (PoolsetBuilder()
+          .SetPoolSize(pool_size_)
+          .SetPartSize(part_size_)
+          .SetReplicaCount(mount_dirs_.size() - 1)
+          .SetName(name)
+          .SetMountDirs(mount_dirs_)
+          .Build(local_dimm_config->GetTestDir(), poolset_) != 0) {
+    return -1;
+  }
+
+  return p_mgmt_.CreatePoolsetFile(poolset_);
+}
+
+double ReplicationAmplification::RunWorkload() {
+  PMEMoid root = pmemobj_root(pop_, root_size_);
+  if (OID_IS_NULL(root)) {
+    std::cerr << pmemobj_errormsg() << std::endl;
+    return 0;
+  }
+
+  auto root_data = static_cast<char *>(pmemobj_direct(root));
+  size_t slots = root_size_ / write_size_;
+  PerfCounters::Scope counting(counters_);
+  bench_utils::Stopwatch stopwatch;
+
+  for (unsigned i = 0; i < operations_; ++i) {
+    if (i % 2 == 0) {
+      size_t offset = (i / 2 % slots) * write_size_;
+
+      /* failed transaction is already aborted and only needs to be ended */
+      if (pmemobj_tx_begin(pop_, nullptr, TX_PARAM_NONE) != 0 ||
+          pmemobj_tx_add_range(root, offset, write_size_) != 0) {
+        pmemobj_tx_end();
+        std::cerr << pmemobj_errormsg() << std::endl;
+        return 0;
+      }
+      memset(root_data + offset, static_cast<int>(i), write_size_);
+      pmemobj_tx_commit();
+      pmemobj_tx_end();
+    } else {
+      PMEMoid oid;
+
+      if (pmemobj_alloc(pop_, &oid, write_size_, 0, nullptr, nullptr) != 0) {
+        std::cerr << pmemobj_errormsg() << std::endl;
+        return 0;
+      }
+      pmemobj_memset_persist(pop_, pmemobj_direct(oid), static_cast<int>(i),
+                             write_size_);
+    }
+  }
+
+  return operations_ / stopwatch.GetElapsedSeconds();
+}
+
+double ReplicationAmplification::GetBaselineThroughput() {
+  if (baseline_throughput_ > 0) {
+    return baseline_throughput_;
+  }
+
+  std::vector<std::string> mount_dirs = std::move(mount_dirs_);
+  mount_dirs_ = {(*local_dimm_config)[0].GetTestDir()};
+  if (BuildPoolset("replication_baseline") != 0) {
+    mount_dirs_ = std::move(mount_dirs);
+    return 0;
+  }
+
+  pop_ = pmemobj_create(poolset_.GetFullPath().c_str(), nullptr, 0, 0644);
+  if (pop_ == nullptr) {
+    std::cerr << pmemobj_errormsg() << std::endl;
+  } else {
+    baseline_throughput_ = RunWorkload();
+    pmemobj_close(pop_);
+    pop_ = nullptr;
+  }
+
+  p_mgmt_.RemovePartsFromPoolset(poolset_);
+  p_mgmt_.RemovePoolsetFile(poolset_);
+  mount_dirs_ = std::move(mount_dirs);
+  return baseline_throughput_;
+}
+
+int ReplicationAmplification::GetBytesWritten(
+    std::vector<unsigned long long> &bytes) const {
+  std::vector<unsigned long long> devices;
+
+  for (const auto &dir : mount_dirs_) {
+    FileStat file_stat;
+    if (ApiC::GetFileStat(dir, file_stat) != 0) {
+      return -1;
+    }
+    if (std::find(devices.begin(), devices.end(), file_stat.device) ==
+        devices.end()) {
+      devices.emplace_back(file_stat.device);
+    }
+  }
+
+  bytes.clear();
+  for (auto device : devices) {
+    unsigned long long device_bytes;
+    if (bench_utils::GetDeviceBytesWritten(device, device_bytes) != 0) {
+      return -1;
+    }
+    bytes.emplace_back(device_bytes);
+  }
+
+  return 0;
+}
+
+double ReplicationAmplification::GetAmplification(
+    const std::vector<unsigned long long> &before,
+    const std::vector<unsigned long long> &after) const {
+  if (before.empty() || before.size() != after.size()) {
+    return -1;
+  }
+
+  unsigned long long written = 0;
+  for (size_t i = 0; i < before.size(); ++i) {
+    if (after[i] <= before[i]) {
+      return -1;
+    }
+    written += after[i] - before[i];
+  }
+
+  return written / (static_cast<double>(operations_) * write_size_);
+}
+
+void ReplicationAmplification::TearDown() {
+  if (pop_ != nullptr) {
+    pmemobj_close(pop_);
+  }
+
+  p_mgmt_.RemovePartsFromPoolset(poolset_);
+  p_mgmt_.RemovePoolsetFile(poolset_);
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_BENCHMARKS_DIMM_REPLICATION_REPLICATION_H_
+#define PMDK_TESTS_SRC_BENCHMARKS_DIMM_REPLICATION_REPLICATION_H_
+
+#include <libpmemobj.h>
+#include <memory>
+#include <tuple>
+#include "bench_utils.h"
+#include "configXML/local_dimm_configuration.h"
+#include "gtest/gtest.h"
+#include "poolset/poolset_builder.h"
+#include "poolset/poolset_management.h"
+
+extern std::unique_ptr<LocalDimmConfiguration> local_dimm_config;
+
+/*
+ * ReplicaPlacement -- kind of device replicas are placed on. Master replica is
+ * always placed on the first namespace. In mixed placement odd replicas are
+ * placed on namespaces and even ones on non-pmem test directory.
+ */
+enum class ReplicaPlacement { dimm, non_pmem, mixed };
+
+/*
+ * ReplicationAmplification -- measures throughput loss and write amplification
+ * of transactional workload on pool set with given number of local replicas
+ * placed according to given ReplicaPlacement.
+ */
+class ReplicationAmplification
+    : public ::testing::TestWithParam<std::tuple<unsigned, ReplicaPlacement>> {
+ private:
+  PoolsetManagement p_mgmt_;
+  static double baseline_throughput_;
+
+ public:
+  const size_t pool_size_ = 256 * MEBIBYTE;
+  const size_t part_size_ = 64 * MEBIBYTE;
+  const size_t write_size_ = 256;
+  const size_t root_size_ = MEBIBYTE;
+  const unsigned operations_ = 100000;
+
+  PMEMobjpool *pop_ = nullptr;
+  Poolset poolset_;
+  std::vector<std::string> mount_dirs_;
+  /* hardware events of the last RunWorkload call */
+  PerfCounters counters_;
+
+  /*
+   * GetMountDirs -- fills mount_dirs_ with directories of master replica and
+   * given number of replicas placed according to placement. Returns 0 on
+   * success, prints message and returns -1 if not enough namespaces are
+   * configured.
+   */
+  int GetMountDirs(unsigned replicas, ReplicaPlacement placement);
+
+  /*
+   * BuildPoolset -- generates pool set placed on mount_dirs_, one replica per
+   * directory, and creates its file. Returns 0 on success, -1 otherwise.
+   */
+  int BuildPoolset(const std::string &name);
+
+  /*
+   * RunWorkload -- runs operations_ operations, alternately updating root
+   * object in transaction and allocating and writing new object, each of
+   * write_size_ bytes, counting hardware events meanwhile. Returns throughput
+   * in operations per second, or 0 if any operation failed.
+   */
+  double RunWorkload();
+
+  /*
+   * GetBaselineThroughput -- returns throughput of the workload on pool set
+   * without replicas, measuring it on the first call. Returns 0 on failure.
+   */
+  double GetBaselineThroughput();
+
+  /*
+   * GetBytesWritten -- retrieves bytes written to each distinct block device
+   * of mount_dirs_, in order of their first appearance. Returns 0 on success,
+   * -1 if statistics of any device are not available.
+   */
+  int GetBytesWritten(std::vector<unsigned long long> &bytes) const;
+
+  /*
+   * GetAmplification -- returns bytes written to devices per logical byte
+   * between two GetBytesWritten readings. Returns -1 unless statistics of
+   * every device moved, as they do not for DAX mappings, in which case
+   * replicas on such devices would be left out of the sum.
+   */
+  double GetAmplification(const std::vector<unsigned long long> &before,
+                          const std::vector<unsigned long long> &after) const;
+
+  void TearDown() override;
+};
+
+#endif  // !PMDK_TESTS_SRC_BENCHMARKS_DIMM_REPLICATION_REPLICATION_H_
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "replication.h"
+
+/**
+ * REPLICATION_AMPLIFICATION
+ * Measuring throughput loss and write amplification caused by local replicas
+ * placed on namespaces, on non-pmem test directory or on both
+ * \test
+ *          \li \c Step1. Measure throughput of the workload on pool set
+ *          without replicas, unless measured by previous test / SUCCESS
+ *          \li \c Step2. Generate pool set with master replica on the first
+ *          namespace and replicas placed as given / SUCCESS
+ *          \li \c Step3. Create pmemobj pool on the pool set / SUCCESS
+ *          \li \c Step4. Run the workload of transactional updates and
+ *          allocations, report throughput, its loss against pool set
+ *          without replicas and hardware events per operation
+ *          \li \c Step5. Report bytes written to devices per byte written by
+ *          the workload if statistics of every device were updated, otherwise
+ *          (e.g. for DAX mappings) report number of replicas plus one as
+ *          estimated amplification
+ */
+TEST_P(ReplicationAmplification, REPLICATION_AMPLIFICATION) {
+  unsigned replicas;
+  ReplicaPlacement placement;
+  std::tie(replicas, placement) = GetParam();
+
+  if (GetMountDirs(replicas, placement) != 0) {
+    return;
+  }
+
+  /* Step 1 */
+  double baseline = GetBaselineThroughput();
+  ASSERT_LT(0, baseline);
+  /* Step 2 */
+  ASSERT_EQ(0, BuildPoolset("replication"));
+  /* Step 3 */
+  pop_ = pmemobj_create(poolset_.GetFullPath().c_str(), nullptr, 0, 0644);
+  ASSERT_TRUE(pop_ != nullptr) << pmemobj_errormsg();
+  /* Step 4 */
+  std::vector<unsigned long long> bytes_before, bytes_after;
+  bool device_stats = GetBytesWritten(bytes_before) == 0;
+  double throughput = RunWorkload();
+  ASSERT_LT(0, throughput);
+  pmemobj_close(pop_);
+  pop_ = nullptr;
+  device_stats = device_stats && GetBytesWritten(bytes_after) == 0;
+
+  bench_utils::ReportResult("throughput", throughput, "ops/s");
+  bench_utils::ReportResult("throughput_loss",
+                            (1 - throughput / baseline) * 100, "%");
+  bench_utils::ReportCounters("workload", counters_, operations_);
+  /* Step 5 */
+  double amplification =
+      device_stats ? GetAmplification(bytes_before, bytes_after) : -1;
+  if (amplification > 0) {
+    bench_utils::ReportResult("bytes_per_logical_byte", amplification, "B/B");
+  } else {
+    bench_utils::ReportResult("estimated_amplification", replicas + 1, "B/B");
+  }
+}
+
+/* placement does not matter without replicas */
+INSTANTIATE_TEST_CASE_P(
+    NoReplicas, ReplicationAmplification,
+    ::testing::Values(std::make_tuple(0u, ReplicaPlacement::dimm)));
+
+INSTANTIATE_TEST_CASE_P(
+    Replication, ReplicationAmplification,
+    ::testing::Combine(::testing::Values(1u, 2u, 3u),
+                       ::testing::Values(ReplicaPlacement::dimm,
+                                         ReplicaPlacement::non_pmem,
+                                         ReplicaPlacement::mixed)));
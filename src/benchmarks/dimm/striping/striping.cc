@@ -0,0 +1,117 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "striping.h"
+#include <atomic>
+
+int StripingBandwidth::BuildPoolset(unsigned namespaces, unsigned replicas) {
+  std::vector<std::string> mount_dirs;
+  for (unsigned i = 0; i < namespaces; ++i) {
+    mount_dirs.emplace_back((*local_dimm_config)[i].GetTestDir());
+  }
+
+  if (PoolsetBuilder()
+          .SetPoolSize(pool_size_)
+          .SetPartSize(part_size_)
+          .SetReplicaCount(replicas)
+          .SetName("striping")
+          .SetMountDirs(mount_dirs)
+          .Build(local_dimm_config->GetTestDir(), poolset_) != 0) {
+    return -1;
+  }
+
+  return p_mgmt_.CreatePoolsetFile(poolset_);
+}
+
+size_t StripingBandwidth::AllocateObjects() {
+  PMEMoid oid;
+
+  while (pmemobj_alloc(pop_, &oid, object_size_, 0, nullptr, nullptr) == 0) {
+    objects_.emplace_back(oid);
+  }
+
+  return objects_.size() * object_size_;
+}
+
+double StripingBandwidth::WriteObjects(int numa_node) {
+  PerfCounters::Scope counting(counters_);
+  return bench_utils::RunParallel(
+      threads_,
+      [this](unsigned thread) {
+        size_t begin = objects_.size() * thread / threads_;
+        size_t end = objects_.size() * (thread + 1) / threads_;
+
+        for (size_t i = begin; i < end; ++i) {
+          pmemobj_memset_persist(pop_, pmemobj_direct(objects_[i]),
+                                 static_cast<int>(i), object_size_);
+        }
+      },
+      numa_node);
+}
+
+double StripingBandwidth::ReadObjects(int numa_node) {
+  std::atomic<uint64_t> checksum{0};
+  double seconds;
+
+  {
+    PerfCounters::Scope counting(counters_);
+    seconds = bench_utils::RunParallel(
+        threads_,
+        [&](unsigned thread) {
+          size_t begin = objects_.size() * thread / threads_;
+          size_t end = objects_.size() * (thread + 1) / threads_;
+          uint64_t sum = 0;
+
+          for (size_t i = begin; i < end; ++i) {
+            auto data =
+                static_cast<const uint64_t *>(pmemobj_direct(objects_[i]));
+            for (size_t j = 0; j < object_size_ / sizeof(uint64_t); ++j) {
+              sum += data[j];
+            }
+          }
+          checksum += sum;
+        },
+        numa_node);
+  }
+
+  bench_utils::DoNotOptimize(checksum);
+  return seconds;
+}
+
+void StripingBandwidth::TearDown() {
+  if (pop_ != nullptr) {
+    pmemobj_close(pop_);
+  }
+
+  p_mgmt_.RemovePartsFromPoolset(poolset_);
+  p_mgmt_.RemovePoolsetFile(poolset_);
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_BENCHMARKS_DIMM_STRIPING_STRIPING_H_
+#define PMDK_TESTS_SRC_BENCHMARKS_DIMM_STRIPING_STRIPING_H_
+
+#include <libpmemobj.h>
+#include <memory>
+#include <tuple>
+#include "bench_utils.h"
+#include "configXML/local_dimm_configuration.h"
+#include "gtest/gtest.h"
+#include "poolset/poolset_builder.h"
+#include "poolset/poolset_management.h"
+
+extern std::unique_ptr<LocalDimmConfiguration> local_dimm_config;
+
+/*
+ * StripingBandwidth -- measures bandwidth of pool striped by PoolsetBuilder.
+ * Parameters are the number of namespaces pool set is placed on, the number
+ * of replicas created in addition to the master replica and placement of
+ * threads relative to NUMA node of the first namespace.
+ */
+class StripingBandwidth
+    : public ::testing::TestWithParam<
+          std::tuple<unsigned, unsigned, bench_utils::NumaPlacement>> {
+ private:
+  PoolsetManagement p_mgmt_;
+  std::vector<PMEMoid> objects_;
+
+ public:
+  const size_t pool_size_ = 2 * GIGIBYTE;
+  const size_t part_size_ = 64 * MEBIBYTE;
+  const size_t object_size_ = 4 * MEBIBYTE;
+  const unsigned threads_ = 8;
+
+  PMEMobjpool *pop_ = nullptr;
+  Poolset poolset_;
+  /* hardware events of the last WriteObjects or ReadObjects call */
+  PerfCounters counters_;
+
+  /*
+   * BuildPoolset -- generates pool set placed on given number of namespaces
+   * and creates its file. Returns 0 on success, -1 otherwise.
+   */
+  int BuildPoolset(unsigned namespaces, unsigned replicas);
+
+  /*
+   * AllocateObjects -- fills the pool with objects of object_size_. Returns
+   * number of allocated bytes.
+   */
+  size_t AllocateObjects();
+
+  /*
+   * WriteObjects -- persistently writes all allocated objects, splitting them
+   * into contiguous ranges handled by separate threads bound to given NUMA
+   * node unless it is negative, and counts hardware events meanwhile. Returns
+   * elapsed time in seconds, -1 if threads could not be bound.
+   */
+  double WriteObjects(int numa_node);
+
+  /*
+   * ReadObjects -- reads all allocated objects in the same manner as
+   * WriteObjects. Returns elapsed time in seconds, -1 if threads could not be
+   * bound.
+   */
+  double ReadObjects(int numa_node);
+
+  void TearDown() override;
+};
+
+#endif  // !PMDK_TESTS_SRC_BENCHMARKS_DIMM_STRIPING_STRIPING_H_
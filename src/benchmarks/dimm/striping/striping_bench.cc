@@ -0,0 +1,114 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "striping.h"
+
+/**
+ * STRIPING_BANDWIDTH
+ * Measuring bandwidth of pool set with parts interleaved across given number
+ * of namespaces, with given number of replicas placed off the namespaces of
+ * the master replica, accessed by unbound threads or by threads bound to NUMA
+ * node of the first namespace or to the nearest other node
+ * \test
+ *          \li \c Step1. Find NUMA node of the first namespace and node of
+ *          threads for given placement, unless threads are unbound
+ *          \li \c Step2. Generate pool set with PoolsetBuilder / SUCCESS
+ *          \li \c Step3. Create pmemobj pool on the pool set / SUCCESS
+ *          \li \c Step4. Fill the pool with objects / SUCCESS
+ *          \li \c Step5. Write all objects in parallel and report write
+ *          bandwidth and hardware events per object
+ *          \li \c Step6. Read all objects in parallel and report read
+ *          bandwidth and hardware events per object
+ */
+TEST_P(StripingBandwidth, STRIPING_BANDWIDTH) {
+  unsigned namespaces, replicas;
+  bench_utils::NumaPlacement placement;
+  std::tie(namespaces, replicas, placement) = GetParam();
+
+  if (local_dimm_config->GetSize() < namespaces || namespaces <= replicas) {
+    std::cout << "Not enough namespaces configured, benchmark skipped"
+              << std::endl;
+    return;
+  }
+
+  /* Step 1 */
+  int thread_node = -1;
+  if (placement != bench_utils::NumaPlacement::unbound) {
+    int pool_node = (*local_dimm_config)[0].GetNumaNode();
+    if (pool_node < 0) {
+      std::cout << "NUMA node of namespace is unknown, benchmark skipped"
+                << std::endl;
+      return;
+    }
+    thread_node = bench_utils::GetThreadNumaNode(pool_node, placement);
+    if (thread_node < 0) {
+      std::cout
+          << "No NUMA node with CPUs for the placement, benchmark skipped"
+          << std::endl;
+      return;
+    }
+    RecordProperty("pool_numa_node", pool_node);
+    RecordProperty("thread_numa_node", thread_node);
+  }
+  /* Step 2 */
+  ASSERT_EQ(0, BuildPoolset(namespaces, replicas));
+  /* Step 3 */
+  pop_ = pmemobj_create(poolset_.GetFullPath().c_str(), nullptr, 0, 0644);
+  ASSERT_TRUE(pop_ != nullptr) << pmemobj_errormsg();
+  /* Step 4 */
+  size_t bytes = AllocateObjects();
+  ASSERT_LT(0, bytes);
+  /* Step 5 */
+  double seconds = WriteObjects(thread_node);
+  ASSERT_LT(0, seconds);
+  bench_utils::ReportResult("write_bandwidth",
+                            bench_utils::GetBandwidth(bytes, seconds), "GiB/s");
+  bench_utils::ReportCounters("write", counters_, bytes / object_size_);
+  /* Step 6 */
+  seconds = ReadObjects(thread_node);
+  ASSERT_LT(0, seconds);
+  bench_utils::ReportResult("read_bandwidth",
+                            bench_utils::GetBandwidth(bytes, seconds), "GiB/s");
+  bench_utils::ReportCounters("read", counters_, bytes / object_size_);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Striping, StripingBandwidth,
+    ::testing::Combine(::testing::Values(1u, 2u, 4u, 8u),
+                       ::testing::Values(0u, 1u),
+                       ::testing::Values(bench_utils::NumaPlacement::unbound)));
+
+INSTANTIATE_TEST_CASE_P(
+    Numa, StripingBandwidth,
+    ::testing::Combine(::testing::Values(1u), ::testing::Values(0u),
+                       ::testing::Values(bench_utils::NumaPlacement::local,
+                                         bench_utils::NumaPlacement::remote)));
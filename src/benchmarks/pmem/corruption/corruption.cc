@@ -0,0 +1,152 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "corruption.h"
+#include <libpmemblk.h>
+#include <libpmemlog.h>
+#include <libpmemobj.h>
+#include <vector>
+#include "api_c/api_c.h"
+
+int CorruptionCost::CreatePool(CorruptionTarget target, size_t pool_size) {
+  std::vector<char> data(block_size_, 'x');
+
+  switch (target) {
+    case CorruptionTarget::PoolHeader: {
+      if (PoolsetBuilder()
+              .SetPoolSize(pool_size)
+              .SetPartSize(pool_size / parts_)
+              .SetName("corruption")
+              .SetMountDirs({local_config->GetTestDir()})
+              .Build(local_config->GetTestDir(), poolset_) != 0) {
+        return -1;
+      }
+      if (p_mgmt_.CreatePoolsetFile(poolset_) != 0) {
+        return -1;
+      }
+      pool_path_ = poolset_.GetFullPath();
+      PMEMobjpool *pop =
+          pmemobj_create(pool_path_.c_str(), nullptr, 0, 0644);
+      if (pop == nullptr) {
+        std::cerr << pmemobj_errormsg() << std::endl;
+        return -1;
+      }
+      pmemobj_close(pop);
+      return 0;
+    }
+    case CorruptionTarget::HeapZone: {
+      pool_path_ = local_config->GetTestDir() + "corruption.obj";
+      PMEMobjpool *pop =
+          pmemobj_create(pool_path_.c_str(), nullptr, pool_size, 0644);
+      if (pop == nullptr) {
+        std::cerr << pmemobj_errormsg() << std::endl;
+        return -1;
+      }
+      for (unsigned i = 0; i < writes_; ++i) {
+        if (pmemobj_alloc(pop, nullptr, object_size_, 0, nullptr, nullptr) !=
+            0) {
+          break;
+        }
+      }
+      pmemobj_close(pop);
+      return 0;
+    }
+    case CorruptionTarget::BttInfo:
+    case CorruptionTarget::BttFlog: {
+      pool_path_ = local_config->GetTestDir() + "corruption.blk";
+      PMEMblkpool *pbp =
+          pmemblk_create(pool_path_.c_str(), block_size_, pool_size, 0644);
+      if (pbp == nullptr) {
+        std::cerr << pmemblk_errormsg() << std::endl;
+        return -1;
+      }
+      /* writes go through flog, so that it holds valid entries */
+      for (unsigned i = 0; i < writes_ && i < pmemblk_nblock(pbp); ++i) {
+        pmemblk_write(pbp, data.data(), i);
+      }
+      pmemblk_close(pbp);
+      return 0;
+    }
+    case CorruptionTarget::LogDescriptor: {
+      pool_path_ = local_config->GetTestDir() + "corruption.log";
+      PMEMlogpool *plp =
+          pmemlog_create(pool_path_.c_str(), pool_size, 0644);
+      if (plp == nullptr) {
+        std::cerr << pmemlog_errormsg() << std::endl;
+        return -1;
+      }
+      for (unsigned i = 0; i < writes_; ++i) {
+        if (pmemlog_append(plp, data.data(), data.size()) != 0) {
+          break;
+        }
+      }
+      pmemlog_close(plp);
+      return 0;
+    }
+  }
+
+  return -1;
+}
+
+RecoveryResult CorruptionCost::CheckHeap() const {
+  RecoveryResult result;
+  bench_utils::Stopwatch stopwatch;
+
+  result.path = pool_path_;
+  int ret = pmemobj_check(pool_path_.c_str(), nullptr);
+  result.seconds = stopwatch.GetElapsedSeconds();
+  result.success = ret == 1;
+  if (ret == 0) {
+    result.message = "heap is not consistent";
+  } else if (ret == -1) {
+    result.message = pmemobj_errormsg();
+  }
+
+  return result;
+}
+
+std::string CorruptionCost::GetDamagedFile(CorruptionTarget target) const {
+  if (target == CorruptionTarget::PoolHeader) {
+    return poolset_.GetReplica(0).GetPart(1).GetPath();
+  }
+
+  return pool_path_;
+}
+
+void CorruptionCost::TearDown() {
+  if (!poolset_.GetReplicas().empty()) {
+    p_mgmt_.RemovePartsFromPoolset(poolset_);
+    p_mgmt_.RemovePoolsetFile(poolset_);
+  } else if (ApiC::RegularFileExists(pool_path_)) {
+    ApiC::RemoveFile(pool_path_);
+  }
+}
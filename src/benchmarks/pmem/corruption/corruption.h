@@ -0,0 +1,91 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_BENCHMARKS_PMEM_CORRUPTION_CORRUPTION_H_
+#define PMDK_TESTS_SRC_BENCHMARKS_PMEM_CORRUPTION_CORRUPTION_H_
+
+#include <memory>
+#include <tuple>
+#include "bench_utils.h"
+#include "configXML/local_configuration.h"
+#include "fault_injection/pool_corruptor.h"
+#include "gtest/gtest.h"
+#include "poolset/poolset_builder.h"
+#include "poolset/poolset_management.h"
+#include "recovery/recovery_orchestrator.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+/*
+ * CorruptionCost -- measures time pmempool_check needs to detect and to repair
+ * damage of given extent done to given structure of pool of given size. Pool
+ * header is damaged in the second part of pmemobj pool set, other targets in
+ * single file pool of type holding them.
+ */
+class CorruptionCost
+    : public ::testing::TestWithParam<std::tuple<
+          CorruptionTarget, size_t, unsigned long long, CorruptionMode>> {
+ private:
+  PoolsetManagement p_mgmt_;
+
+ public:
+  const unsigned parts_ = 4;
+  const size_t block_size_ = 4 * KIBIBYTE;
+  const size_t object_size_ = 4 * KIBIBYTE;
+  const unsigned writes_ = 1024;
+
+  Poolset poolset_;
+  std::string pool_path_;
+
+  /*
+   * CreatePool -- creates pool holding given target and fills it with data.
+   * Sets pool_path_ to path checked by pmempool_check. Returns 0 on success,
+   * prints error message and returns -1 otherwise.
+   */
+  int CreatePool(CorruptionTarget target, size_t pool_size);
+
+  /*
+   * CheckHeap -- checks consistency of pmemobj pool with pmemobj_check,
+   * which unlike pmempool_check validates its heap. Returns result of the
+   * check.
+   */
+  RecoveryResult CheckHeap() const;
+
+  /*
+   * GetDamagedFile -- returns path of file holding damaged target.
+   */
+  std::string GetDamagedFile(CorruptionTarget target) const;
+
+  void TearDown() override;
+};
+
+#endif  // !PMDK_TESTS_SRC_BENCHMARKS_PMEM_CORRUPTION_CORRUPTION_H_
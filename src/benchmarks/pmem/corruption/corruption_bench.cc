@@ -0,0 +1,99 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "corruption.h"
+
+/**
+ * CORRUPTION_COST
+ * Measuring time of detection and repair by pmempool_check of damage done to
+ * pool header, BTT metadata, heap zone or log descriptor on file level
+ * \test
+ *          \li \c Step1. Create pool holding given target and fill it with
+ *          data / SUCCESS
+ *          \li \c Step2. Zero or flip bits in given number of bytes of the
+ *          target, located from pool descriptors / SUCCESS
+ *          \li \c Step3. Run pmempool_check without repair, or pmemobj_check
+ *          for heap zone, report detection time and whether damage was
+ *          detected
+ *          \li \c Step4. Run pmempool_check with repair, report repair time
+ *          and whether pool is consistent after repair, for heap zone as
+ *          reported by pmemobj_check
+ */
+TEST_P(CorruptionCost, CORRUPTION_COST) {
+  CorruptionTarget target;
+  size_t pool_size;
+  unsigned long long extent;
+  CorruptionMode mode;
+  std::tie(target, pool_size, extent, mode) = GetParam();
+
+  if (!bench_utils::HasFreeSpace(local_config->GetTestDir(), pool_size)) {
+    return;
+  }
+
+  /* Step 1 */
+  ASSERT_EQ(0, CreatePool(target, pool_size));
+  /* Step 2 */
+  CorruptionRange range;
+  ASSERT_EQ(0, PoolCorruptor(GetDamagedFile(target))
+                   .Corrupt(target, mode, extent, range));
+  bench_utils::ReportResult("damaged_bytes", range.length, "B");
+  /* Step 3 */
+  /* pmempool_check does not validate heap of pmemobj pool */
+  bool heap = target == CorruptionTarget::HeapZone;
+  RecoveryResult detection =
+      heap ? CheckHeap()
+           : RecoveryOrchestrator::Recover(pool_path_, RecoveryAction::Check);
+  bench_utils::ReportResult("detection_time", detection.seconds, "s");
+  bench_utils::ReportResult("detected", detection.success ? 0 : 1, "");
+  /* Step 4 */
+  RecoveryResult repair =
+      RecoveryOrchestrator::Recover(pool_path_, RecoveryAction::Repair);
+  bench_utils::ReportResult("repair_time", repair.seconds, "s");
+  if (heap && repair.success) {
+    repair.success = CheckHeap().success;
+  }
+  bench_utils::ReportResult("consistent_after_repair", repair.success ? 1 : 0,
+                            "");
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Corruption, CorruptionCost,
+    ::testing::Combine(::testing::Values(CorruptionTarget::PoolHeader,
+                                         CorruptionTarget::BttInfo,
+                                         CorruptionTarget::BttFlog,
+                                         CorruptionTarget::HeapZone,
+                                         CorruptionTarget::LogDescriptor),
+                       ::testing::Values(64 * MEBIBYTE, GIGIBYTE,
+                                         16 * GIGIBYTE),
+                       ::testing::Values(64ull, 4096ull),
+                       ::testing::Values(CorruptionMode::Zero,
+                                         CorruptionMode::FlipBits)));
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "heap_growth.h"
+
+void HeapGrowth::AllocateUntilFull(size_t target_size,
+                                   Histogram &latencies) {
+  size_t allocated = 0;
+  PMEMoid oid;
+
+  while (allocated < target_size) {
+    uint64_t start = Timer::ReadTicks();
+    int ret = pmemobj_alloc(pop_, &oid, object_size_, 0, nullptr, nullptr);
+    uint64_t latency = Timer::GetElapsedNanoseconds(start);
+
+    if (ret != 0) {
+      break;
+    }
+
+    latencies.Record(latency);
+    allocated += object_size_;
+  }
+}
+
+size_t HeapGrowth::CountPoolFiles() const {
+  std::vector<std::string> entries;
+  ApiC::ListDirectory(poolset_.GetReplica(0).GetPart(0).GetPath(), entries);
+  return entries.size();
+}
+
+void HeapGrowth::ReportLatencies(const std::string &name,
+                                 const Histogram &latencies) const {
+  const double ns_per_us = 1e3;
+  uint64_t median = latencies.GetPercentile(50);
+  uint64_t stalls = 0;
+  double stall_total = 0;
+
+  latencies.ForEachBucket([&](uint64_t latency, uint64_t count) {
+    if (latency > stall_factor_ * median) {
+      stalls += count;
+      stall_total += static_cast<double>(latency) * count;
+    }
+  });
+
+  bench_utils::ReportResult(name + "_median", median / ns_per_us, "us");
+  bench_utils::ReportResult(name + "_p99",
+                            latencies.GetPercentile(99) / ns_per_us, "us");
+  bench_utils::ReportResult(name + "_max", latencies.GetMax() / ns_per_us,
+                            "us");
+  bench_utils::ReportResult(name + "_stalls", stalls, "");
+
+  if (stalls != 0) {
+    bench_utils::ReportResult(name + "_stall_avg",
+                              stall_total / stalls / ns_per_us, "us");
+  }
+}
+
+void HeapGrowth::SetUp() {
+  ASSERT_EQ(0, p_mgmt_.CreatePoolsetFile(poolset_));
+  ASSERT_EQ(0, p_mgmt_.CreatePartDirectories(poolset_));
+  pop_ = pmemobj_create(poolset_.GetFullPath().c_str(), nullptr, 0, 0644);
+  ASSERT_TRUE(pop_ != nullptr) << pmemobj_errormsg();
+}
+
+void HeapGrowth::TearDown() {
+  if (pop_ != nullptr) {
+    pmemobj_close(pop_);
+  }
+
+  p_mgmt_.RemovePartsFromPoolset(poolset_);
+  p_mgmt_.RemovePoolsetFile(poolset_);
+}
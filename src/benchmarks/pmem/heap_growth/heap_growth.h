@@ -0,0 +1,96 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_BENCHMARKS_PMEM_HEAP_GROWTH_HEAP_GROWTH_H_
+#define PMDK_TESTS_SRC_BENCHMARKS_PMEM_HEAP_GROWTH_HEAP_GROWTH_H_
+
+#include <libpmemobj.h>
+#include <memory>
+#include "bench_utils.h"
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "histogram/histogram.h"
+#include "poolset/poolset_management.h"
+#include "timer/timer.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+/*
+ * HeapGrowth -- fixture creating pmemobj pool on a pool set with a single
+ * directory part, which starts small and grows as heap is extended.
+ */
+class HeapGrowth : public ::testing::TestWithParam<size_t> {
+ private:
+  PoolsetManagement p_mgmt_;
+
+ public:
+  const size_t max_size_ = 4 * GIGIBYTE;
+  const size_t object_size_ = 256 * KIBIBYTE;
+  /* allocation slower than that multiple of the median is a stall */
+  const double stall_factor_ = 10.0;
+
+  PMEMobjpool *pop_ = nullptr;
+  Poolset poolset_{local_config->GetTestDir(),
+                   "heap_growth.set",
+                   {{"PMEMPOOLSET", std::to_string(max_size_) + " " +
+                                        local_config->GetTestDir() +
+                                        "heap_growth" + SEPARATOR}}};
+
+  /*
+   * AllocateUntilFull -- allocates objects until allocation fails or
+   * target_size bytes are allocated. Latency of each allocation in
+   * nanoseconds is recorded in latencies.
+   */
+  void AllocateUntilFull(size_t target_size, Histogram &latencies);
+
+  /*
+   * CountPoolFiles -- returns number of files libpmemobj created in the
+   * directory part.
+   */
+  size_t CountPoolFiles() const;
+
+  /*
+   * ReportLatencies -- reports median, 99th percentile and maximum latency
+   * along with number and average duration of allocation stalls.
+   */
+  void ReportLatencies(const std::string &name,
+                       const Histogram &latencies) const;
+
+  void SetUp() override;
+  void TearDown() override;
+};
+
+class HeapAutoGrowth : public HeapGrowth {};
+
+class HeapExplicitExtend : public HeapGrowth {};
+
+#endif  // !PMDK_TESTS_SRC_BENCHMARKS_PMEM_HEAP_GROWTH_HEAP_GROWTH_H_
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "heap_growth.h"
+
+/**
+ * HEAP_AUTO_GROWTH
+ * Measuring allocation latency while libpmemobj extends the heap of growable
+ * pool automatically by given granularity
+ * \test
+ *          \li \c Step1. Set heap growth granularity / SUCCESS
+ *          \li \c Step2. Allocate objects until half of the maximal pool size
+ *          is allocated, measuring latency of each allocation / SUCCESS
+ *          \li \c Step3. Report allocation latencies, number of allocation
+ *          stalls and number of files created in the directory part
+ */
+TEST_P(HeapAutoGrowth, HEAP_AUTO_GROWTH) {
+  if (!bench_utils::HasFreeSpace(local_config->GetTestDir(), max_size_ / 2)) {
+    return;
+  }
+
+  /* Step 1 */
+  uint64_t granularity = GetParam();
+  ASSERT_EQ(0, pmemobj_ctl_set(pop_, "heap.size.granularity", &granularity))
+      << pmemobj_errormsg();
+  size_t initial_files = CountPoolFiles();
+  /* Step 2 */
+  Histogram latencies;
+  AllocateUntilFull(max_size_ / 2, latencies);
+  ASSERT_NE(0u, latencies.GetCount());
+  /* Step 3 */
+  ReportLatencies("alloc", latencies);
+  bench_utils::ReportResult("grow_events", CountPoolFiles() - initial_files,
+                            "");
+}
+
+INSTANTIATE_TEST_CASE_P(Granularity, HeapAutoGrowth,
+                        ::testing::Values(8 * MEBIBYTE, 32 * MEBIBYTE,
+                                          128 * MEBIBYTE));
+
+/**
+ * HEAP_EXPLICIT_EXTEND
+ * Measuring latency of explicit heap extension of growable pool with automatic
+ * growth disabled
+ * \test
+ *          \li \c Step1. Disable automatic heap growth / SUCCESS
+ *          \li \c Step2. Allocate objects until allocation fails
+ *          \li \c Step3. Extend the heap by given size with heap.size.extend
+ *          and measure its latency / SUCCESS
+ *          \li \c Step4. Repeat steps 2-3 until half of the maximal pool size
+ *          is allocated
+ *          \li \c Step5. Report extension and allocation latencies
+ */
+TEST_P(HeapExplicitExtend, HEAP_EXPLICIT_EXTEND) {
+  if (!bench_utils::HasFreeSpace(local_config->GetTestDir(), max_size_ / 2)) {
+    return;
+  }
+
+  /* Step 1 */
+  uint64_t granularity = 0;
+  ASSERT_EQ(0, pmemobj_ctl_set(pop_, "heap.size.granularity", &granularity))
+      << pmemobj_errormsg();
+  uint64_t extend_size = GetParam();
+  Histogram alloc_latencies;
+  Histogram extend_latencies;
+
+  do {
+    /* Step 2 */
+    AllocateUntilFull(max_size_ / 2 - alloc_latencies.GetCount() * object_size_,
+                      alloc_latencies);
+    if (alloc_latencies.GetCount() * object_size_ >= max_size_ / 2) {
+      break;
+    }
+    /* Step 3 */
+    uint64_t start = Timer::ReadTicks();
+    ASSERT_EQ(0, pmemobj_ctl_exec(pop_, "heap.size.extend", &extend_size))
+        << pmemobj_errormsg();
+    extend_latencies.Record(Timer::GetElapsedNanoseconds(start));
+    /* Step 4 */
+  } while (alloc_latencies.GetCount() * object_size_ < max_size_ / 2);
+
+  /* Step 5 */
+  ReportLatencies("extend", extend_latencies);
+  ReportLatencies("alloc", alloc_latencies);
+}
+
+INSTANTIATE_TEST_CASE_P(ExtendSize, HeapExplicitExtend,
+                        ::testing::Values(8 * MEBIBYTE, 32 * MEBIBYTE,
+                                          128 * MEBIBYTE));
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <exception>
+#include <iostream>
+#include <memory>
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "result_listener.h"
+#include "test_utils/timing_listener.h"
+#include "timer/timer.h"
+
+std::unique_ptr<LocalConfiguration> local_config{new LocalConfiguration()};
+
+int main(int argc, char **argv) {
+  int ret = 0;
+  try {
+    if (local_config->ReadConfigFile() != 0) {
+      return -1;
+    }
+
+    ::testing::InitGoogleTest(&argc, argv);
+    if (TimingListener::Install(argc, argv) != 0 ||
+        ResultListener::Install(argc, argv) != 0) {
+      return -1;
+    }
+    /* without invariant TSC latencies are measured with monotonic clock */
+    Timer::Calibrate();
+    std::cout << "Persistent memory mode: " << local_config->GetPmemMode()
+              << std::endl;
+    ::testing::Test::RecordProperty("pmem_mode", local_config->GetPmemMode());
+    ret = RUN_ALL_TESTS();
+  } catch (const std::exception &e) {
+    std::cerr << "Exception was caught: " << e.what() << std::endl;
+    ret = -1;
+  }
+
+  ApiC::CleanDirectory(local_config->GetTestDir());
+  ApiC::RemoveDirectoryT(local_config->GetTestDir());
+
+  return ret;
+}
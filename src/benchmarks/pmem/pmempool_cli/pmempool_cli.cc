@@ -0,0 +1,131 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "pmempool_cli.h"
+#include "api_c/api_c.h"
+
+void PrintTo(const PmempoolCliCase &cli_case, std::ostream *os) {
+  using struct_utils::ConvertEnum;
+
+  *os << "pmempool "
+      << struct_utils::SUBCOMMANDS[ConvertEnum<int>(cli_case.subcommand)]
+      << struct_utils::POOL_TYPES[ConvertEnum<int>(
+             cli_case.pool_args.pool_type)]
+      << struct_utils::CombineArguments(cli_case.pool_args.args)
+      << "size: " << cli_case.pool_size << " parts: " << cli_case.parts;
+}
+
+std::vector<PmempoolCliCase> GetPmempoolCliCases() {
+  const std::vector<PoolArgs> pools{
+      {PoolType::Obj},
+      {PoolType::Blk, {{Option::BSize, OptionType::Long, "512"}}},
+      {PoolType::Blk, {{Option::BSize, OptionType::Long, "4096"}}},
+      {PoolType::Log}};
+  const std::vector<size_t> sizes{64 * MEBIBYTE, GIGIBYTE, 16 * GIGIBYTE};
+  const std::vector<unsigned> layouts{0, 8};
+  std::vector<PmempoolCliCase> cases;
+
+  for (int i = 0; i < struct_utils::ConvertEnum<int>(Subcommand::Count); ++i) {
+    auto subcommand = static_cast<Subcommand>(i);
+
+    for (const auto &pool : pools) {
+      /* dump does not support pmemobj pools, convert supports only them */
+      if ((subcommand == Subcommand::Dump &&
+           pool.pool_type == PoolType::Obj) ||
+          (subcommand == Subcommand::Convert &&
+           pool.pool_type != PoolType::Obj)) {
+        continue;
+      }
+
+      for (auto size : sizes) {
+        for (auto parts : layouts) {
+          cases.push_back({subcommand, pool, size, parts});
+        }
+      }
+    }
+  }
+
+  return cases;
+}
+
+std::string PmempoolCli::PreparePath(const PmempoolCliCase &cli_case) {
+  if (cli_case.parts == 0) {
+    return pool_path_;
+  }
+
+  if (PoolsetBuilder()
+          .SetPoolSize(cli_case.pool_size)
+          .SetPartSize(cli_case.pool_size / cli_case.parts)
+          .SetName("cli")
+          .SetMountDirs({local_config->GetTestDir()})
+          .Build(local_config->GetTestDir(), poolset_) != 0) {
+    return "";
+  }
+
+  if (p_mgmt_.CreatePoolsetFile(poolset_) != 0) {
+    return "";
+  }
+
+  return poolset_.GetFullPath();
+}
+
+std::string PmempoolCli::GetCreateCommand(const PmempoolCliCase &cli_case,
+                                          const std::string &path) {
+  std::vector<Arg> args = cli_case.pool_args.args;
+
+  /* size of pool set is given by its parts */
+  if (cli_case.parts == 0) {
+    args.emplace_back(Option::Size, OptionType::Long,
+                      std::to_string(cli_case.pool_size));
+  }
+
+  return "pmempool create " +
+         struct_utils::POOL_TYPES[struct_utils::ConvertEnum<int>(
+             cli_case.pool_args.pool_type)] +
+         struct_utils::CombineArguments(args) + path;
+}
+
+std::string PmempoolCli::GetCommand(const PmempoolCliCase &cli_case,
+                                    const std::string &path) {
+  if (cli_case.subcommand == Subcommand::Create) {
+    return GetCreateCommand(cli_case, path);
+  }
+
+  return "pmempool " +
+         struct_utils::SUBCOMMANDS[struct_utils::ConvertEnum<int>(
+             cli_case.subcommand)] +
+         path;
+}
+
+void PmempoolCli::TearDown() {
+  ApiC::CleanDirectory(local_config->GetTestDir());
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_BENCHMARKS_PMEM_PMEMPOOL_CLI_PMEMPOOL_CLI_H_
+#define PMDK_TESTS_SRC_BENCHMARKS_PMEM_PMEMPOOL_CLI_PMEMPOOL_CLI_H_
+
+#include <memory>
+#include <ostream>
+#include "bench_utils.h"
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "poolset/poolset_builder.h"
+#include "poolset/poolset_management.h"
+#include "structures.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+/*
+ * PmempoolCliCase -- pmempool subcommand run on pool created with given
+ * arguments, of given size, placed in single file or on pool set with given
+ * number of parts.
+ */
+struct PmempoolCliCase {
+  Subcommand subcommand;
+  PoolArgs pool_args;
+  size_t pool_size;
+  unsigned parts;
+};
+
+void PrintTo(const PmempoolCliCase &cli_case, std::ostream *os);
+
+/*
+ * GetPmempoolCliCases -- returns matrix of subcommands, pool types, block
+ * sizes, pool sizes and layouts, without subcommands not supporting pool type.
+ */
+std::vector<PmempoolCliCase> GetPmempoolCliCases();
+
+/*
+ * PmempoolCli -- measures wall time and resources used by pmempool subcommands
+ * run as separate processes.
+ */
+class PmempoolCli : public ::testing::TestWithParam<PmempoolCliCase> {
+ private:
+  PoolsetManagement p_mgmt_;
+  Poolset poolset_;
+
+ public:
+  const std::string pool_path_ = local_config->GetTestDir() + "pool.file";
+
+  /*
+   * PreparePath -- returns path of pool file, or of pool set file which is
+   * generated and created for pool set layouts. Returns empty string on
+   * failure.
+   */
+  std::string PreparePath(const PmempoolCliCase &cli_case);
+
+  /*
+   * GetCreateCommand -- returns pmempool command creating pool of given case.
+   */
+  static std::string GetCreateCommand(const PmempoolCliCase &cli_case,
+                                      const std::string &path);
+
+  /*
+   * GetCommand -- returns pmempool command measured in given case.
+   */
+  static std::string GetCommand(const PmempoolCliCase &cli_case,
+                                const std::string &path);
+
+  void TearDown() override;
+};
+
+#endif  // !PMDK_TESTS_SRC_BENCHMARKS_PMEM_PMEMPOOL_CLI_PMEMPOOL_CLI_H_
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "pmempool_cli.h"
+
+/**
+ * PMEMPOOL_CLI
+ * Measuring wall time, CPU time, peak RSS, page faults and storage I/O of
+ * pmempool create, info, check, dump, rm and convert subcommands run on pools
+ * of different types, block sizes, sizes and layouts
+ * \test
+ *          \li \c Step1. Generate pool set file for pool set layouts / SUCCESS
+ *          \li \c Step2. Create pool with pmempool create, unless create is
+ *          measured / SUCCESS
+ *          \li \c Step3. Run measured subcommand as separate process /
+ *          SUCCESS
+ *          \li \c Step4. Report time and resources used by the process
+ */
+TEST_P(PmempoolCli, PMEMPOOL_CLI) {
+  const PmempoolCliCase &cli_case = GetParam();
+  bench_utils::ProcessUsage usage;
+
+  if (!bench_utils::HasFreeSpace(local_config->GetTestDir(),
+                                 cli_case.pool_size)) {
+    return;
+  }
+
+  /* Step 1 */
+  std::string path = PreparePath(cli_case);
+  ASSERT_FALSE(path.empty());
+  /* Step 2 */
+  if (cli_case.subcommand != Subcommand::Create) {
+    ASSERT_EQ(0, bench_utils::RunProcess(GetCreateCommand(cli_case, path),
+                                         usage));
+    ASSERT_EQ(0, usage.exit_code) << GetCreateCommand(cli_case, path);
+  }
+  /* Step 3 */
+  std::string command = GetCommand(cli_case, path);
+  ASSERT_EQ(0, bench_utils::RunProcess(command, usage));
+  if (cli_case.subcommand == Subcommand::Convert && usage.exit_code != 0) {
+    std::cout << "pmempool convert is not supported, benchmark skipped"
+              << std::endl;
+    return;
+  }
+  ASSERT_EQ(0, usage.exit_code) << command;
+  /* Step 4 */
+  bench_utils::ReportResult("wall_time", usage.seconds, "s");
+  bench_utils::ReportResult("cpu_time", usage.cpu_seconds, "s");
+  bench_utils::ReportResult("peak_rss", usage.max_rss_kib / 1024.0, "MiB");
+  bench_utils::ReportResult("page_faults", usage.page_faults, "");
+  bench_utils::ReportResult("read_bytes",
+                            usage.read_bytes / static_cast<double>(MEBIBYTE),
+                            "MiB");
+  bench_utils::ReportResult("write_bytes",
+                            usage.write_bytes / static_cast<double>(MEBIBYTE),
+                            "MiB");
+}
+
+INSTANTIATE_TEST_CASE_P(PmempoolCli, PmempoolCli,
+                        ::testing::ValuesIn(GetPmempoolCliCases()));
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "poolset_scalability.h"
+
+double PoolsetScalability::baseline_latency_ = 0;
+
+int PoolsetScalability::BuildPoolset(unsigned parts, unsigned replicas,
+                                     size_t part_size) {
+  /* each replica gets its own copy of the test directory */
+  std::vector<std::string> mount_dirs(replicas, local_config->GetTestDir());
+
+  if (PoolsetBuilder()
+          .SetPoolSize(parts * part_size)
+          .SetPartSize(part_size)
+          .SetReplicaCount(replicas - 1)
+          .SetName("scalability")
+          .SetMountDirs(mount_dirs)
+          .Build(local_config->GetTestDir(), poolset_) != 0) {
+    return -1;
+  }
+
+  return p_mgmt_.CreatePoolsetFile(poolset_);
+}
+
+double PoolsetScalability::MeasureWriteLatency(PMEMobjpool *pop) const {
+  PMEMoid root = pmemobj_root(pop, write_size_);
+  void *dest = pmemobj_direct(root);
+  std::vector<char> buffer(write_size_);
+
+  bench_utils::Stopwatch stopwatch;
+  for (unsigned i = 0; i < writes_; ++i) {
+    buffer[0] = static_cast<char>(i);
+    pmemobj_memcpy_persist(pop, dest, buffer.data(), buffer.size());
+  }
+
+  return stopwatch.GetElapsedSeconds() / writes_;
+}
+
+double PoolsetScalability::GetBaselineLatency() {
+  if (baseline_latency_ > 0) {
+    return baseline_latency_;
+  }
+
+  std::string path = local_config->GetTestDir() + "baseline.pool";
+  PMEMobjpool *pop =
+      pmemobj_create(path.c_str(), nullptr, PMEMOBJ_MIN_POOL, 0644);
+
+  if (pop == nullptr) {
+    std::cerr << pmemobj_errormsg() << std::endl;
+    return 0;
+  }
+
+  baseline_latency_ = MeasureWriteLatency(pop);
+  pmemobj_close(pop);
+  ApiC::RemoveFile(path);
+
+  return baseline_latency_;
+}
+
+void PoolsetScalability::TearDown() {
+  if (pop_ != nullptr) {
+    pmemobj_close(pop_);
+  }
+
+  p_mgmt_.RemovePartsFromPoolset(poolset_);
+  p_mgmt_.RemovePoolsetFile(poolset_);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_BENCHMARKS_PMEM_POOLSET_SCALABILITY_POOLSET_SCALABILITY_H_
+#define PMDK_TESTS_SRC_BENCHMARKS_PMEM_POOLSET_SCALABILITY_POOLSET_SCALABILITY_H_
+
+#include <libpmemobj.h>
+#include <memory>
+#include <tuple>
+#include "bench_utils.h"
+#include "configXML/local_configuration.h"
+#include "gtest/gtest.h"
+#include "poolset/poolset_builder.h"
+#include "poolset/poolset_management.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+/*
+ * PoolsetScalability -- measures cost of libpmemobj handling of pool sets
+ * with many parts and replicas. Parameters are the number of parts in each
+ * replica, the total number of replicas and the size of a single part.
+ */
+class PoolsetScalability
+    : public ::testing::TestWithParam<std::tuple<unsigned, unsigned, size_t>> {
+ private:
+  PoolsetManagement p_mgmt_;
+  static double baseline_latency_;
+
+ public:
+  const size_t write_size_ = 256;
+  const unsigned writes_ = 10000;
+
+  PMEMobjpool *pop_ = nullptr;
+  Poolset poolset_;
+
+  /*
+   * BuildPoolset -- generates pool set in the test directory and creates its
+   * file. Returns 0 on success, -1 otherwise.
+   */
+  int BuildPoolset(unsigned parts, unsigned replicas, size_t part_size);
+
+  /*
+   * MeasureWriteLatency -- returns average latency in seconds of persistent
+   * write of write_size_ bytes to the root object of given pool.
+   */
+  double MeasureWriteLatency(PMEMobjpool *pop) const;
+
+  /*
+   * GetBaselineLatency -- returns write latency measured once on a single
+   * file pool without replicas. Returns 0 on failure.
+   */
+  double GetBaselineLatency();
+
+  void TearDown() override;
+};
+
+#endif  // !PMDK_TESTS_SRC_BENCHMARKS_PMEM_POOLSET_SCALABILITY_POOLSET_SCALABILITY_H_
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "poolset_scalability.h"
+
+/**
+ * POOLSET_SCALABILITY
+ * Measuring creation and open time, number of memory mappings and write
+ * latency of pmemobj pool on pool sets with given number of parts and
+ * replicas. Configurations smaller than PMEMOBJ_MIN_POOL or not fitting in
+ * the test directory are skipped.
+ * \test
+ *          \li \c Step1. Generate pool set file / SUCCESS
+ *          \li \c Step2. Create pmemobj pool on the pool set, measure its
+ *          creation time and close it / SUCCESS
+ *          \li \c Step3. Open the pool and measure its open time and number
+ *          of mappings it added / SUCCESS
+ *          \li \c Step4. Measure latency of persistent writes to the pool and
+ *          its ratio to the latency on single file pool without replicas
+ */
+TEST_P(PoolsetScalability, POOLSET_SCALABILITY) {
+  unsigned parts, replicas;
+  size_t part_size;
+  std::tie(parts, replicas, part_size) = GetParam();
+  size_t pool_size = parts * part_size;
+
+  if (pool_size < PMEMOBJ_MIN_POOL) {
+    std::cout << "Pool smaller than PMEMOBJ_MIN_POOL, benchmark skipped"
+              << std::endl;
+    return;
+  }
+
+  if (!bench_utils::HasFreeSpace(local_config->GetTestDir(),
+                                 pool_size * replicas + PMEMOBJ_MIN_POOL)) {
+    return;
+  }
+
+  double baseline = GetBaselineLatency();
+  ASSERT_LT(0, baseline);
+
+  /* Step 1 */
+  ASSERT_EQ(0, BuildPoolset(parts, replicas, part_size));
+  /* Step 2 */
+  bench_utils::Stopwatch stopwatch;
+  pop_ = pmemobj_create(poolset_.GetFullPath().c_str(), nullptr, 0, 0644);
+  double create_time = stopwatch.GetElapsedSeconds();
+  ASSERT_TRUE(pop_ != nullptr) << pmemobj_errormsg();
+  pmemobj_close(pop_);
+  /* Step 3 */
+  int mappings = bench_utils::CountMappings();
+  stopwatch.Start();
+  pop_ = pmemobj_open(poolset_.GetFullPath().c_str(), nullptr);
+  double open_time = stopwatch.GetElapsedSeconds();
+  ASSERT_TRUE(pop_ != nullptr) << pmemobj_errormsg();
+  mappings = bench_utils::CountMappings() - mappings;
+  /* Step 4 */
+  double latency = MeasureWriteLatency(pop_);
+
+  bench_utils::ReportResult("create_time", create_time * 1e3, "ms");
+  bench_utils::ReportResult("open_time", open_time * 1e3, "ms");
+  bench_utils::ReportResult("mappings", mappings, "");
+  bench_utils::ReportResult("write_latency", latency * 1e9, "ns");
+  bench_utils::ReportResult("replication_overhead", latency / baseline, "x");
+}
+
+INSTANTIATE_TEST_CASE_P(
+    PartsReplicas, PoolsetScalability,
+    ::testing::Combine(::testing::Values(1u, 10u, 100u, 1000u, 10000u),
+                       ::testing::Values(1u, 2u, 4u, 8u),
+                       ::testing::Values(2 * MEBIBYTE, 16 * MEBIBYTE)));
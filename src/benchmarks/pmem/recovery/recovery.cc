@@ -0,0 +1,171 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "recovery.h"
+#include <vector>
+#include "api_c/api_c.h"
+
+unsigned long long RecoveryTime::GetRequiredSpace(RecoveryCase recovery_case,
+                                                  size_t pool_size) {
+  if (recovery_case == RecoveryCase::check_repair_corrupted_header) {
+    return pool_size;
+  }
+
+  return 2ull * pool_size;
+}
+
+int RecoveryTime::CreatePool(RecoveryCase recovery_case, size_t pool_size) {
+  unsigned replicas =
+      recovery_case == RecoveryCase::check_repair_corrupted_header ? 0 : 1;
+  std::vector<std::string> mount_dirs(replicas + 1,
+                                      local_config->GetTestDir());
+  Poolset &built =
+      recovery_case == RecoveryCase::transform_lost_replica ? target_
+                                                            : poolset_;
+
+  if (PoolsetBuilder()
+          .SetPoolSize(pool_size)
+          .SetPartSize(pool_size / parts_)
+          .SetReplicaCount(replicas)
+          .SetName("recovery")
+          .SetMountDirs(mount_dirs)
+          .Build(local_config->GetTestDir(), built) != 0) {
+    return -1;
+  }
+
+  if (recovery_case == RecoveryCase::transform_lost_replica) {
+    /* pool is created without the replica, as if it was already dropped */
+    poolset_ = Poolset(local_config->GetTestDir(), "recovery_origin.set",
+                       std::vector<Replica>{target_.GetReplica(0)}, {});
+    if (p_mgmt_.CreatePoolsetFile(target_) != 0) {
+      return -1;
+    }
+  }
+
+  if (p_mgmt_.CreatePoolsetFile(poolset_) != 0) {
+    return -1;
+  }
+
+  PMEMobjpool *pop =
+      pmemobj_create(poolset_.GetFullPath().c_str(), nullptr, 0, 0644);
+  if (pop == nullptr) {
+    std::cerr << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+  pmemobj_close(pop);
+
+  return 0;
+}
+
+int RecoveryTime::Damage(RecoveryCase recovery_case) {
+  CorruptionRange range;
+
+  switch (recovery_case) {
+    case RecoveryCase::sync_deleted_part:
+      return ApiC::RemoveFile(poolset_.GetReplica(1).GetPart(0).GetPath());
+    case RecoveryCase::sync_corrupted_part:
+      return PoolCorruptor(poolset_.GetReplica(1).GetPart(0).GetPath())
+          .Corrupt(CorruptionTarget::PoolHeader, CorruptionMode::Zero,
+                   header_size_, range);
+    case RecoveryCase::check_repair_corrupted_header:
+      return PoolCorruptor(poolset_.GetReplica(0).GetPart(parts_ - 1).GetPath())
+          .Corrupt(CorruptionTarget::PoolHeader, CorruptionMode::Zero,
+                   header_size_, range);
+    case RecoveryCase::transform_lost_replica:
+      return 0;
+  }
+
+  return -1;
+}
+
+int RecoveryTime::Recover(RecoveryCase recovery_case) {
+  int ret = -1;
+
+  switch (recovery_case) {
+    case RecoveryCase::sync_deleted_part:
+    case RecoveryCase::sync_corrupted_part:
+      ret = pmempool_sync(poolset_.GetFullPath().c_str(), 0);
+      break;
+    case RecoveryCase::check_repair_corrupted_header:
+      return CheckRepair(poolset_.GetFullPath());
+    case RecoveryCase::transform_lost_replica:
+      ret = pmempool_transform(poolset_.GetFullPath().c_str(),
+                               target_.GetFullPath().c_str(), 0);
+      break;
+  }
+
+  if (ret != 0) {
+    std::cerr << pmempool_errormsg() << std::endl;
+  }
+
+  return ret;
+}
+
+int RecoveryTime::CheckRepair(const std::string &path) {
+  unsigned flags = PMEMPOOL_CHECK_FORMAT_STR | PMEMPOOL_CHECK_REPAIR |
+                   PMEMPOOL_CHECK_ALWAYS_YES;
+  struct pmempool_check_args args = {path.c_str(), nullptr,
+                                     PMEMPOOL_POOL_TYPE_DETECT, flags};
+
+  PMEMpoolcheck *ppc = pmempool_check_init(&args, sizeof(args));
+  if (ppc == nullptr) {
+    std::cerr << "pmempool_check_init failed: " << pmempool_errormsg()
+              << std::endl;
+    return -1;
+  }
+
+  /* questions are answered with PMEMPOOL_CHECK_ALWAYS_YES */
+  while (pmempool_check(ppc) != nullptr) {
+  }
+
+  enum pmempool_check_result result = pmempool_check_end(ppc);
+  if (result != PMEMPOOL_CHECK_RESULT_REPAIRED &&
+      result != PMEMPOOL_CHECK_RESULT_CONSISTENT) {
+    std::cerr << "Pool " << path << " was not repaired, check result: "
+              << result << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+void RecoveryTime::TearDown() {
+  if (!target_.GetReplicas().empty()) {
+    p_mgmt_.RemovePartsFromPoolset(target_);
+    p_mgmt_.RemovePoolsetFile(target_);
+    p_mgmt_.RemovePoolsetFile(poolset_);
+    return;
+  }
+
+  p_mgmt_.RemovePartsFromPoolset(poolset_);
+  p_mgmt_.RemovePoolsetFile(poolset_);
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_BENCHMARKS_PMEM_RECOVERY_RECOVERY_H_
+#define PMDK_TESTS_SRC_BENCHMARKS_PMEM_RECOVERY_RECOVERY_H_
+
+#include <libpmemobj.h>
+#include <libpmempool.h>
+#include <memory>
+#include <tuple>
+#include "bench_utils.h"
+#include "configXML/local_configuration.h"
+#include "fault_injection/pool_corruptor.h"
+#include "gtest/gtest.h"
+#include "poolset/poolset_builder.h"
+#include "poolset/poolset_management.h"
+
+extern std::unique_ptr<LocalConfiguration> local_config;
+
+/*
+ * RecoveryCase -- damage done to the pool and operation recovering it.
+ */
+enum class RecoveryCase {
+  /* part of replica deleted, restored by pmempool_sync */
+  sync_deleted_part,
+  /* header of replica part zeroed, restored by pmempool_sync */
+  sync_corrupted_part,
+  /* header of master replica part zeroed, restored by pmempool_check */
+  check_repair_corrupted_header,
+  /* replica lost, recreated on new location by pmempool_transform */
+  transform_lost_replica
+};
+
+/*
+ * RecoveryTime -- measures time needed by libpmempool to recover pmemobj pool
+ * of given size after given damage done directly to its files.
+ */
+class RecoveryTime
+    : public ::testing::TestWithParam<std::tuple<RecoveryCase, size_t>> {
+ private:
+  PoolsetManagement p_mgmt_;
+
+ public:
+  const unsigned parts_ = 8;
+  const size_t header_size_ = 4 * KIBIBYTE;
+
+  /* pool set damaged and recovered */
+  Poolset poolset_;
+  /* pool set with replica recreated by pmempool_transform */
+  Poolset target_;
+
+  /*
+   * GetRequiredSpace -- returns number of bytes needed in the test directory
+   * to run given recovery case on pool of given size.
+   */
+  static unsigned long long GetRequiredSpace(RecoveryCase recovery_case,
+                                             size_t pool_size);
+
+  /*
+   * CreatePool -- generates pool set of given size with parts_ parts per
+   * replica and creates pmemobj pool on it. Returns 0 on success, prints error
+   * message and returns -1 otherwise.
+   */
+  int CreatePool(RecoveryCase recovery_case, size_t pool_size);
+
+  /*
+   * Damage -- deletes or corrupts part of the pool as given recovery case
+   * requires. Returns 0 on success, prints error message and returns -1
+   * otherwise.
+   */
+  int Damage(RecoveryCase recovery_case);
+
+  /*
+   * Recover -- runs libpmempool operation recovering the pool. Returns 0 on
+   * success, prints error message and returns -1 otherwise.
+   */
+  int Recover(RecoveryCase recovery_case);
+
+  /*
+   * CheckRepair -- runs pmempool_check with repair on pool set of given path.
+   * Returns 0 if pool was repaired or found consistent, prints error message
+   * and returns -1 otherwise.
+   */
+  static int CheckRepair(const std::string &path);
+
+  void TearDown() override;
+};
+
+#endif  // !PMDK_TESTS_SRC_BENCHMARKS_PMEM_RECOVERY_RECOVERY_H_
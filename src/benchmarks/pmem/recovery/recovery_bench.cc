@@ -0,0 +1,88 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "recovery.h"
+
+/**
+ * RECOVERY_TIME
+ * Measuring time and throughput of pmempool_sync, pmempool_check repair and
+ * pmempool_transform recovering pool damaged directly on regular files
+ * \test
+ *          \li \c Step1. Create pmemobj pool of given size on pool set with
+ *          replica (none for check repair case) / SUCCESS
+ *          \li \c Step2. Delete or corrupt part of the pool set as given
+ *          recovery case requires / SUCCESS
+ *          \li \c Step3. Recover the pool with libpmempool operation, report
+ *          recovery time and pool size recovered per second / SUCCESS
+ *          \li \c Step4. Open recovered pool / SUCCESS
+ */
+TEST_P(RecoveryTime, RECOVERY_TIME) {
+  RecoveryCase recovery_case;
+  size_t pool_size;
+  std::tie(recovery_case, pool_size) = GetParam();
+
+  if (!bench_utils::HasFreeSpace(
+          local_config->GetTestDir(),
+          GetRequiredSpace(recovery_case, pool_size))) {
+    return;
+  }
+
+  /* Step 1 */
+  ASSERT_EQ(0, CreatePool(recovery_case, pool_size));
+  /* Step 2 */
+  ASSERT_EQ(0, Damage(recovery_case));
+  /* Step 3 */
+  bench_utils::Stopwatch stopwatch;
+  ASSERT_EQ(0, Recover(recovery_case));
+  double seconds = stopwatch.GetElapsedSeconds();
+
+  bench_utils::ReportResult("recovery_time", seconds, "s");
+  bench_utils::ReportResult(
+      "throughput", bench_utils::GetBandwidth(pool_size, seconds), "GiB/s");
+  /* Step 4 */
+  const Poolset &recovered =
+      recovery_case == RecoveryCase::transform_lost_replica ? target_
+                                                            : poolset_;
+  PMEMobjpool *pop = pmemobj_open(recovered.GetFullPath().c_str(), nullptr);
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+  pmemobj_close(pop);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Recovery, RecoveryTime,
+    ::testing::Combine(
+        ::testing::Values(RecoveryCase::sync_deleted_part,
+                          RecoveryCase::sync_corrupted_part,
+                          RecoveryCase::check_repair_corrupted_header,
+                          RecoveryCase::transform_lost_replica),
+        ::testing::Values(GIGIBYTE, 4 * GIGIBYTE, 16 * GIGIBYTE,
+                          64 * GIGIBYTE, 256 * GIGIBYTE)));
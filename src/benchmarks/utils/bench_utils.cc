@@ -0,0 +1,317 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench_utils.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "api_c/api_c.h"
+#include "gtest/gtest.h"
+#include "result_listener.h"
+#include "string_view/string_view.h"
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/sysmacros.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif  // __linux__
+
+namespace bench_utils {
+namespace {
+volatile uint64_t sink;
+
+/*
+ * GetNumaDistance -- returns distance between NUMA nodes from the node's
+ * sysfs distance attribute, or maximal int if it is not known.
+ */
+int GetNumaDistance(int from, unsigned to) {
+#ifdef __linux__
+  std::ifstream distances("/sys/devices/system/node/node" +
+                          std::to_string(from) + "/distance");
+  int distance;
+
+  for (unsigned node = 0; distances >> distance; ++node) {
+    if (node == to) {
+      return distance;
+    }
+  }
+#else
+  (void)from;
+  (void)to;
+#endif  // __linux__
+  return std::numeric_limits<int>::max();
+}
+}  // namespace
+
+double RunParallel(unsigned threads,
+                   const std::function<void(unsigned)> &worker,
+                   int numa_node) {
+  std::vector<std::thread> pool;
+  std::atomic<bool> bound{true};
+  Stopwatch stopwatch;
+
+  for (unsigned i = 0; i < threads; ++i) {
+    pool.emplace_back([&, i]() {
+      if (numa_node >= 0 &&
+          ApiC::BindThreadToNumaNode(static_cast<unsigned>(numa_node)) != 0) {
+        bound = false;
+        return;
+      }
+      worker(i);
+    });
+  }
+
+  for (auto &thread : pool) {
+    thread.join();
+  }
+
+  return bound ? stopwatch.GetElapsedSeconds() : -1;
+}
+
+int GetThreadNumaNode(int memory_node, NumaPlacement placement) {
+  std::vector<unsigned> nodes, cpus;
+
+  if (placement == NumaPlacement::unbound || memory_node < 0 ||
+      ApiC::GetOnlineNumaNodes(nodes) != 0) {
+    return -1;
+  }
+
+  int nearest = -1;
+  int nearest_distance = std::numeric_limits<int>::max();
+  for (unsigned node : nodes) {
+    bool is_local = static_cast<int>(node) == memory_node;
+    if (is_local != (placement == NumaPlacement::local) ||
+        ApiC::GetNumaNodeCpus(node, cpus) != 0 || cpus.empty()) {
+      continue;
+    }
+
+    int distance = GetNumaDistance(memory_node, node);
+    if (nearest < 0 || distance < nearest_distance) {
+      nearest = static_cast<int>(node);
+      nearest_distance = distance;
+    }
+  }
+
+  return nearest;
+}
+
+double GetPercentile(std::vector<double> samples, double percent) {
+  if (samples.empty()) {
+    return 0;
+  }
+
+  size_t rank = static_cast<size_t>(percent / 100 * (samples.size() - 1));
+  std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+  return samples[rank];
+}
+
+void DoNotOptimize(uint64_t value) {
+  sink = value;
+}
+
+int CountMappings() {
+#ifdef __linux__
+  std::ifstream maps("/proc/self/maps");
+  std::string line;
+  int count = 0;
+
+  while (std::getline(maps, line)) {
+    ++count;
+  }
+
+  return maps.eof() ? count : -1;
+#else
+  return -1;
+#endif  // __linux__
+}
+
+bool HasFreeSpace(const std::string &path, unsigned long long bytes) {
+  long long free_space = ApiC::GetFreeSpaceT(path);
+
+  if (free_space < 0 || static_cast<unsigned long long>(free_space) < bytes) {
+    std::cout << "Not enough free space in " << path << " (" << bytes
+              << " bytes required), benchmark skipped" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+int GetDeviceBytesWritten(unsigned long long device,
+                          unsigned long long &bytes) {
+#ifdef __linux__
+  /* sectors written is the seventh field, counted in 512-byte units */
+  const int sectors_written_field = 7;
+  const unsigned long long sector_size = 512;
+
+  std::ifstream stat("/sys/dev/block/" + std::to_string(major(device)) + ":" +
+                     std::to_string(minor(device)) + "/stat");
+  unsigned long long value = 0;
+
+  for (int i = 0; i < sectors_written_field; ++i) {
+    if (!(stat >> value)) {
+      return -1;
+    }
+  }
+
+  bytes = value * sector_size;
+  return 0;
+#else
+  (void)device;
+  (void)bytes;
+  return -1;
+#endif  // __linux__
+}
+
+int RunProcess(const std::string &command, ProcessUsage &usage) {
+#ifdef __linux__
+  std::vector<std::string> args;
+  StringView rest(command);
+  while (!rest.IsEmpty()) {
+    args.emplace_back(rest.PopToken().ToString());
+  }
+  if (args.empty()) {
+    std::cerr << "Empty command" << std::endl;
+    return -1;
+  }
+
+  std::vector<char *> argv;
+  for (auto &arg : args) {
+    argv.emplace_back(&arg[0]);
+  }
+  argv.emplace_back(nullptr);
+
+  Stopwatch stopwatch;
+  pid_t pid = fork();
+  if (pid < 0) {
+    std::cerr << "fork failed: " << strerror(errno) << std::endl;
+    return -1;
+  }
+  if (pid == 0) {
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd >= 0) {
+      dup2(null_fd, STDOUT_FILENO);
+      dup2(null_fd, STDERR_FILENO);
+    }
+    execvp(argv[0], argv.data());
+    _exit(127);
+  }
+
+  /* I/O accounting is read before the exited process is reaped */
+  siginfo_t info;
+  if (waitid(P_PID, pid, &info, WEXITED | WNOWAIT) != 0) {
+    std::cerr << "waitid failed: " << strerror(errno) << std::endl;
+    return -1;
+  }
+  usage.seconds = stopwatch.GetElapsedSeconds();
+
+  std::ifstream io("/proc/" + std::to_string(pid) + "/io");
+  std::string key;
+  unsigned long long value;
+  while (io >> key >> value) {
+    if (key == "read_bytes:") {
+      usage.read_bytes = value;
+    } else if (key == "write_bytes:") {
+      usage.write_bytes = value;
+    }
+  }
+
+  int status;
+  struct rusage rusage;
+  if (wait4(pid, &status, 0, &rusage) != pid) {
+    std::cerr << "wait4 failed: " << strerror(errno) << std::endl;
+    return -1;
+  }
+
+  usage.exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+  usage.cpu_seconds = rusage.ru_utime.tv_sec + rusage.ru_stime.tv_sec +
+                      (rusage.ru_utime.tv_usec + rusage.ru_stime.tv_usec) / 1e6;
+  usage.max_rss_kib = rusage.ru_maxrss;
+  usage.page_faults = rusage.ru_minflt + rusage.ru_majflt;
+  return 0;
+#else
+  (void)command;
+  (void)usage;
+  std::cerr << "Running processes is not supported on this platform"
+            << std::endl;
+  return -1;
+#endif  // __linux__
+}
+
+void ReportResult(const std::string &metric, double value,
+                  const std::string &unit) {
+  std::ostringstream formatted;
+  formatted << std::fixed << std::setprecision(3) << value;
+
+  std::cout << "[  BENCH   ] " << metric << ": " << formatted.str() << " "
+            << unit << std::endl;
+  ::testing::Test::RecordProperty(metric, formatted.str());
+  ResultListener::AddMetric(metric, value, unit);
+}
+
+void ReportCounters(const std::string &prefix, const PerfCounters &counters,
+                    double operations) {
+  static bool unavailable_reported = false;
+  bool counted = false;
+  double value;
+
+  for (size_t i = 0; i < static_cast<size_t>(PerfEvent::count); ++i) {
+    PerfEvent event = static_cast<PerfEvent>(i);
+    if (operations > 0 && counters.GetValue(event, value)) {
+      ReportResult(prefix + "_" + PerfCounters::GetName(event) + "_per_op",
+                   value / operations, "");
+      counted = true;
+    }
+  }
+
+  double cycles, instructions;
+  if (counters.GetValue(PerfEvent::cycles, cycles) &&
+      counters.GetValue(PerfEvent::instructions, instructions) && cycles > 0) {
+    ReportResult(prefix + "_ipc", instructions / cycles, "");
+  }
+
+  if (!counted && !unavailable_reported) {
+    std::cout << "Hardware performance counters not available ("
+              << counters.GetError() << ")" << std::endl;
+    unavailable_reported = true;
+  }
+}
+}  // namespace bench_utils
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_BENCHMARKS_UTILS_BENCH_UTILS_H_
+#define PMDK_TESTS_SRC_BENCHMARKS_UTILS_BENCH_UTILS_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "perf_counters/perf_counters.h"
+
+namespace bench_utils {
+/*
+ * ProcessUsage -- resources used by process run with RunProcess. Bytes read
+ * and written are those which hit storage, as accounted in /proc/<pid>/io.
+ */
+struct ProcessUsage {
+  int exit_code = -1;
+  double seconds = 0;
+  double cpu_seconds = 0;
+  long max_rss_kib = 0;
+  long page_faults = 0;
+  unsigned long long read_bytes = 0;
+  unsigned long long write_bytes = 0;
+};
+
+/*
+ * NumaPlacement -- placement of benchmark threads relative to NUMA node of
+ * the memory they access. Unbound threads are placed by the scheduler.
+ */
+enum class NumaPlacement { unbound, local, remote };
+
+/*
+ * Stopwatch -- measures wall clock time elapsed since construction or last
+ * call to Start().
+ */
+class Stopwatch final {
+ private:
+  std::chrono::steady_clock::time_point start_ =
+      std::chrono::steady_clock::now();
+
+ public:
+  void Start() {
+    start_ = std::chrono::steady_clock::now();
+  }
+  double GetElapsedSeconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start_)
+        .count();
+  }
+};
+
+/*
+ * RunParallel -- runs worker in given number of threads, passing index of the
+ * thread to each of them. Threads are bound to CPUs of given NUMA node unless
+ * it is negative. Returns wall clock time in seconds elapsed until all
+ * threads finished, or -1 if binding any of them failed.
+ */
+double RunParallel(unsigned threads,
+                   const std::function<void(unsigned)> &worker,
+                   int numa_node = -1);
+
+/*
+ * GetThreadNumaNode -- returns NUMA node with CPUs that threads accessing
+ * memory on memory_node should be bound to for given placement: memory_node
+ * itself or the nearest other one. Returns -1 if threads are unbound,
+ * memory_node is unknown or there is no node with CPUs for the placement.
+ */
+int GetThreadNumaNode(int memory_node, NumaPlacement placement);
+
+/*
+ * GetBandwidth -- returns bandwidth in GiB/s.
+ */
+inline double GetBandwidth(size_t bytes, double seconds) {
+  return seconds > 0 ? bytes / seconds / (1 << 30) : 0;
+}
+
+/*
+ * GetPercentile -- returns value below which given percent of samples fall.
+ * Returns 0 if there are no samples.
+ */
+double GetPercentile(std::vector<double> samples, double percent);
+
+/*
+ * DoNotOptimize -- stores value in a volatile sink, so that the optimizer
+ * cannot drop computation which produces it, e.g. reads of benchmarked
+ * memory.
+ */
+void DoNotOptimize(uint64_t value);
+
+/*
+ * CountMappings -- returns number of memory mappings of the current process.
+ * Returns -1 if it cannot be determined on the current platform.
+ */
+int CountMappings();
+
+/*
+ * HasFreeSpace -- checks that file system containing given path has at least
+ * given number of bytes available. Prints message if it has not.
+ */
+bool HasFreeSpace(const std::string &path, unsigned long long bytes);
+
+/*
+ * GetDeviceBytesWritten -- reads number of bytes written to block device with
+ * given device number from its /sys/dev/block statistics. Does not print error
+ * message, as statistics are not available on every platform and device.
+ * Returns 0 on success, -1 otherwise.
+ */
+int GetDeviceBytesWritten(unsigned long long device, unsigned long long &bytes);
+
+/*
+ * RunProcess -- runs command line split on whitespace, with output discarded,
+ * and waits for its end. Returns 0 if process was run and its usage was
+ * collected, prints error message and returns -1 otherwise.
+ */
+int RunProcess(const std::string &command, ProcessUsage &usage);
+
+/*
+ * ReportResult -- prints result of the current benchmark, records it as
+ * property of the test in Google Test XML output and adds it to the result
+ * written by ResultListener.
+ */
+void ReportResult(const std::string &metric, double value,
+                  const std::string &unit);
+
+/*
+ * ReportCounters -- reports hardware events counted by counters per operation
+ * (and instructions per cycle) with metric names starting with prefix. Prints
+ * once why counters are not available if none were counted.
+ */
+void ReportCounters(const std::string &prefix, const PerfCounters &counters,
+                    double operations);
+}  // namespace bench_utils
+
+#endif  // !PMDK_TESTS_SRC_BENCHMARKS_UTILS_BENCH_UTILS_H_
@@ -0,0 +1,262 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "result_listener.h"
+#include <libpmemobj.h>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include "string_utils.h"
+#ifdef __linux__
+#include <sys/utsname.h>
+#endif  // __linux__
+#ifdef _WIN32
+#include <windows.h>
+#endif  // _WIN32
+
+/* version of libpmemobj found by pkg-config at build time */
+#ifndef PMDK_VERSION
+#define PMDK_VERSION "unknown"
+#endif  // !PMDK_VERSION
+
+namespace {
+const int SCHEMA_VERSION = 1;
+
+std::string GetCpuModel() {
+#ifdef __linux__
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  const std::string key = "model name";
+
+  while (std::getline(cpuinfo, line)) {
+    if (line.compare(0, key.size(), key) == 0) {
+      size_t colon = line.find(':');
+      if (colon != std::string::npos && colon + 2 <= line.size()) {
+        return line.substr(colon + 2);
+      }
+    }
+  }
+#endif  // __linux__
+  return "unknown";
+}
+
+/*
+ * GetHostInfo -- returns JSON object describing host results come from.
+ */
+std::string GetHostInfo() {
+  std::string hostname = "unknown";
+  std::string kernel = "unknown";
+  long long memory = -1;
+
+#ifdef __linux__
+  struct utsname name;
+  if (uname(&name) == 0) {
+    hostname = name.nodename;
+    kernel = name.release;
+  }
+
+  std::ifstream meminfo("/proc/meminfo");
+  std::string key, unit;
+  long long value;
+  while (meminfo >> key >> value >> unit) {
+    if (key == "MemTotal:") {
+      memory = value * 1024;
+      break;
+    }
+  }
+#endif  // __linux__
+#ifdef _WIN32
+  char computer_name[MAX_COMPUTERNAME_LENGTH + 1];
+  DWORD size = sizeof(computer_name);
+  if (GetComputerNameA(computer_name, &size)) {
+    hostname = computer_name;
+  }
+  kernel = "windows";
+
+  MEMORYSTATUSEX status;
+  status.dwLength = sizeof(status);
+  if (GlobalMemoryStatusEx(&status)) {
+    memory = static_cast<long long>(status.ullTotalPhys);
+  }
+#endif  // _WIN32
+
+  std::ostringstream host;
+  host << "{\"hostname\":\"" << string_utils::EscapeJson(hostname)
+       << "\",\"kernel\":\"" << string_utils::EscapeJson(kernel)
+       << "\",\"cpu\":\"" << string_utils::EscapeJson(GetCpuModel())
+       << "\",\"cpus\":" << std::thread::hardware_concurrency()
+       << ",\"memory_bytes\":" << memory << "}";
+  return host.str();
+}
+
+std::string GetTimestamp() {
+  std::time_t now = std::time(nullptr);
+  char timestamp[sizeof("YYYY-MM-DDTHH:MM:SSZ")];
+  std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ",
+                std::gmtime(&now));
+  return timestamp;
+}
+
+std::string GetBaseName(const std::string &path) {
+  size_t separator = path.find_last_of("/\\");
+  return separator == std::string::npos ? path : path.substr(separator + 1);
+}
+}  // namespace
+
+ResultListener *ResultListener::installed_ = nullptr;
+
+int ResultListener::Install(int &argc, char **argv) {
+  ResultListener *listener = new ResultListener();
+
+  if (listener->ParseArguments(argc, argv) != 0) {
+    delete listener;
+    return -1;
+  }
+
+  if (listener->file_path_.empty()) {
+    delete listener;
+    return 0;
+  }
+
+  listener->binary_ = argc > 0 ? GetBaseName(argv[0]) : "unknown";
+
+  /* libpmemobj actually loaded may differ from the one built against */
+  const char *mismatch =
+      pmemobj_check_version(PMEMOBJ_MAJOR_VERSION, PMEMOBJ_MINOR_VERSION);
+  std::ostringstream environment;
+  environment << "\"pmdk_version\":\"" << PMDK_VERSION
+              << "\",\"pmemobj_api\":\"" << PMEMOBJ_MAJOR_VERSION << "."
+              << PMEMOBJ_MINOR_VERSION << "\",\"pmemobj_version_check\":\""
+              << string_utils::EscapeJson(mismatch == nullptr ? "ok" : mismatch)
+              << "\",\"host\":" << GetHostInfo();
+  listener->environment_ = environment.str();
+
+  /* gtest takes ownership of the listener */
+  ::testing::UnitTest::GetInstance()->listeners().Append(listener);
+  installed_ = listener;
+
+  return 0;
+}
+
+ResultListener::~ResultListener() {
+  if (installed_ == this) {
+    installed_ = nullptr;
+  }
+}
+
+int ResultListener::ParseArguments(int &argc, char **argv) {
+  const std::string file_arg = "--results_file=";
+  int i = 1;
+
+  while (i < argc) {
+    std::string arg = argv[i];
+    if (arg.compare(0, file_arg.size(), file_arg) != 0) {
+      ++i;
+      continue;
+    }
+
+    file_path_ = arg.substr(file_arg.size());
+    if (file_path_.empty()) {
+      std::cerr << "Empty path of results file" << std::endl;
+      return -1;
+    }
+
+    for (int j = i; j < argc - 1; ++j) {
+      argv[j] = argv[j + 1];
+    }
+    --argc;
+  }
+
+  return 0;
+}
+
+void ResultListener::AddMetric(const std::string &name, double value,
+                               const std::string &unit) {
+  if (installed_ != nullptr) {
+    installed_->metrics_.emplace_back(Metric{name, value, unit});
+  }
+}
+
+void ResultListener::OnTestStart(const ::testing::TestInfo &) {
+  metrics_.clear();
+}
+
+void ResultListener::OnTestEnd(const ::testing::TestInfo &test_info) {
+  if (!metrics_.empty()) {
+    WriteResult(test_info);
+  }
+}
+
+int ResultListener::WriteResult(const ::testing::TestInfo &test_info) const {
+  std::string param;
+  if (test_info.value_param() != nullptr) {
+    param = test_info.value_param();
+  }
+
+  std::ostringstream line;
+  line << std::setprecision(9) << "{\"schema\":" << SCHEMA_VERSION
+       << ",\"binary\":\"" << string_utils::EscapeJson(binary_)
+       << "\",\"workload\":\""
+       << string_utils::EscapeJson(std::string(test_info.test_case_name()) +
+                                   "." + test_info.name())
+       << "\",\"params\":\"" << string_utils::EscapeJson(param)
+       << "\",\"passed\":"
+       << (test_info.result()->Passed() ? "true" : "false")
+       << ",\"timestamp\":\"" << GetTimestamp() << "\"," << environment_
+       << ",\"metrics\":{";
+  for (const auto &metric : metrics_) {
+    line << (&metric == &metrics_.front() ? "" : ",") << "\""
+         << string_utils::EscapeJson(metric.name) << "\":{\"value\":";
+    /* JSON has no representation of infinity and NaN */
+    if (std::isfinite(metric.value)) {
+      line << metric.value;
+    } else {
+      line << "null";
+    }
+    line << ",\"unit\":\"" << string_utils::EscapeJson(metric.unit) << "\"}";
+  }
+  line << "}}\n";
+
+  /* each line is complete result, so that processes may share the file */
+  std::ofstream file(file_path_, std::ios_base::app);
+  file << line.str() << std::flush;
+  if (!file.good()) {
+    std::cerr << "Cannot write results file: " << file_path_ << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
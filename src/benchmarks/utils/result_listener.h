@@ -0,0 +1,92 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_BENCHMARKS_UTILS_RESULT_LISTENER_H_
+#define PMDK_TESTS_SRC_BENCHMARKS_UTILS_RESULT_LISTENER_H_
+
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+/*
+ * ResultListener -- gtest event listener which appends results reported by
+ * benchmarks to file, one JSON object per finished benchmark (every parameter
+ * instance and repetition) and line, e.g.:
+ * {"schema":1,"binary":"PMEMBENCH","workload":"Case.Test/0","params":"8",
+ *  "passed":true,"timestamp":"2018-06-01T12:00:00Z","pmdk_version":"1.4",
+ *  "pmemobj_api":"2.3","pmemobj_version_check":"ok",
+ *  "host":{"hostname":"h","kernel":"4.15.0","cpu":"...","cpus":8,
+ *  "memory_bytes":8589934592},
+ *  "metrics":{"alloc_p99":{"value":1.5,"unit":"us"}}}
+ * Results of benchmarks which reported no metrics are not written. Files of
+ * two runs can be compared with etc/scripts/compare_results.py.
+ */
+class ResultListener final : public ::testing::EmptyTestEventListener {
+ private:
+  struct Metric {
+    std::string name;
+    double value;
+    std::string unit;
+  };
+
+  static ResultListener *installed_;
+
+  std::string file_path_;
+  std::string binary_;
+  std::string environment_;
+  std::vector<Metric> metrics_;
+
+  int ParseArguments(int &argc, char **argv);
+  int WriteResult(const ::testing::TestInfo &test_info) const;
+
+ public:
+  /*
+   * Install -- consumes '--results_file=PATH' argument (file results are
+   * appended to) and, if given, appends listener to gtest listeners. Has to be
+   * called after ::testing::InitGoogleTest. Returns 0 on success, prints error
+   * message and returns -1 otherwise.
+   */
+  static int Install(int &argc, char **argv);
+
+  /*
+   * AddMetric -- adds metric to result of running benchmark. Does nothing if
+   * listener is not installed.
+   */
+  static void AddMetric(const std::string &name, double value,
+                        const std::string &unit);
+
+  void OnTestStart(const ::testing::TestInfo &test_info) override;
+  void OnTestEnd(const ::testing::TestInfo &test_info) override;
+  ~ResultListener();
+};
+
+#endif  // !PMDK_TESTS_SRC_BENCHMARKS_UTILS_RESULT_LISTENER_H_
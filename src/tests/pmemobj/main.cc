@@ -35,8 +35,28 @@
 #include <memory>
 #include "configXML/local_configuration.h"
 #include "gtest/gtest.h"
+#include "obj_pool_provider.h"
+#include "test_utils/perf_assert.h"
+#include "test_utils/test_dir.h"
+#include "test_utils/test_supervisor.h"
+#include "test_utils/timing_listener.h"
+#include "timer/timer.h"
 
 std::unique_ptr<LocalConfiguration> local_config{new LocalConfiguration()};
+std::unique_ptr<ObjPoolProvider> obj_pools;
+
+/* pool provider keeps acquired pool, shared pool and their golden image, test
+ * may create one more pool of its own, all of minimal size */
+const unsigned long long POOLS_SPACE = 4 * PMEMOBJ_MIN_POOL;
+
+/*
+ * GetPoolsDir -- returns directory of pool provider of process with given
+ * identifier.
+ */
+static std::string GetPoolsDir(unsigned long pid) {
+  return test_utils::GetProcessDir(local_config->GetTestDir(), "obj_pools",
+                                   pid);
+}
 
 int main(int argc, char **argv) {
   int ret;
@@ -44,15 +64,45 @@ int main(int argc, char **argv) {
     if (local_config->ReadConfigFile() != 0) {
       return -1;
     }
+    if (local_config->CheckEmulatedPmemCapacity(POOLS_SPACE) != 0) {
+      return -1;
+    }
+    obj_pools.reset(new ObjPoolProvider(GetPoolsDir(ApiC::GetProcessIdT()),
+                                        PMEMOBJ_MIN_POOL));
     ::testing::InitGoogleTest(&argc, argv);
-    ret = RUN_ALL_TESTS();
+    perf_assert::ExcludePerfTests();
+    if (TimingListener::Install(argc, argv) != 0) {
+      return -1;
+    }
+    /* without invariant TSC latencies are measured with monotonic clock */
+    Timer::Calibrate();
+    std::cout << "Persistent memory mode: " << local_config->GetPmemMode()
+              << std::endl;
+    ::testing::Test::RecordProperty("pmem_mode", local_config->GetPmemMode());
+    TestSupervisor supervisor;
+    if (supervisor.ParseArguments(argc, argv) != 0) {
+      return -1;
+    }
+    /* pools of one child must not be taken over by the next one */
+    supervisor.SetChildSetup([]() {
+      obj_pools.reset(new ObjPoolProvider(GetPoolsDir(ApiC::GetProcessIdT()),
+                                          PMEMOBJ_MIN_POOL));
+      return 0;
+    });
+    supervisor.SetChildCleanup([](unsigned long pid) {
+      /* only files are removed with directory, so images go first */
+      std::string dir = GetPoolsDir(pid);
+      test_utils::RemoveTestDir(ObjPoolProvider::GetImagesDir(dir));
+      test_utils::RemoveTestDir(dir);
+    });
+    ret = supervisor.Run();
   } catch (const std::exception &e) {
     std::cerr << "Exception was caught: " << e.what() << std::endl;
     ret = -1;
   }
-  std::string test_dir = local_config->GetTestDir();
-  ApiC::CleanDirectory(test_dir);
-  ApiC::RemoveDirectoryT(test_dir);
+  obj_pools.reset();
+  /* each test removes its own directory, other test processes may still run */
+  test_utils::RemoveDirectoryIfEmpty(local_config->GetTestDir());
 
   return ret;
 }
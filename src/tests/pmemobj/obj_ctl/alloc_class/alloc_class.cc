@@ -31,12 +31,23 @@
  */
 
 #include "alloc_class.h"
-#include "api_c/api_c.h"
+
+PMEMobjpool *ObjCtlAllocClassTest::AcquirePool() {
+  pop_ = obj_pools->Acquire();
+  return pop_;
+}
+
+void ObjCtlAllocClassTest::ReleasePool() {
+  if (pop_ != nullptr) {
+    obj_pools->Release(pop_);
+    pop_ = nullptr;
+  }
+}
 
 void ObjCtlAllocClassTest::SetUp() {
   errno = 0;
 }
 
 void ObjCtlAllocClassTest::TearDown() {
-  ApiC::RemoveFile(pool_path_);
+  ReleasePool();
 }
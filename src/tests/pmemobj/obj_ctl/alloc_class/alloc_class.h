@@ -41,15 +41,22 @@
 #include <utility>
 #include "configXML/local_configuration.h"
 #include "gtest/gtest.h"
+#include "obj_pool_provider.h"
 
 extern std::unique_ptr<LocalConfiguration> local_config;
+extern std::unique_ptr<ObjPoolProvider> obj_pools;
 
 class ObjCtlAllocClassTest : public ::testing::Test {
  private:
-  std::string test_dir_ = local_config->GetTestDir();
+  PMEMobjpool *pop_ = nullptr;
 
  public:
-  std::string pool_path_ = test_dir_ + "pool";
+  /*
+   * AcquirePool -- returns pristine pool owned by the test. Pool is released
+   * in TearDown if the test does not release it.
+   */
+  PMEMobjpool *AcquirePool();
+  void ReleasePool();
   void SetUp();
   void TearDown();
 };
@@ -33,6 +33,7 @@
 #include "alloc_class.h"
 #include <limits>
 #include "alloc_class_utils.h"
+#include "test_utils/perf_assert.h"
 
 using namespace std;
 
@@ -40,7 +41,7 @@ using namespace std;
  * PMEMOBJ_CTL_CLASS_WITH_SAME_DESC
  * Creating two allocation classes with the same description
  * \test
- *          \li \c Step1. Create pmemobj pool / SUCCESS
+ *          \li \c Step1. Acquire pristine pmemobj pool / SUCCESS
  *          \li \c Step2. Create allocation class automatically / SUCCESS
  *          \li \c Step3. Create allocation class automatically with the same
  *          size as above / FAIL: ret = -1, errno = EINVAL
@@ -50,12 +51,11 @@ using namespace std;
  *          \li \c Step6. Create allocation class automatically / SUCCESS
  *          \li \c Step7. Create allocation class with an id of 130 with the
  *          same size as above / FAIL: ret = -1, errno = EINVAL
- *          \li \c Step8. Close pool / SUCCESS
+ *          \li \c Step8. Release pool / SUCCESS
  */
 TEST_F(ObjCtlAllocClassTest, PMEMOBJ_CTL_CLASS_WITH_SAME_DESC) {
   /* Step 1 */
-  PMEMobjpool *pop =
-      pmemobj_create(pool_path_.c_str(), nullptr, PMEMOBJ_MIN_POOL, 0666);
+  PMEMobjpool *pop = AcquirePool();
   ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
   /* Step 2 */
   pobj_alloc_class_desc write_arg;
@@ -85,23 +85,22 @@ TEST_F(ObjCtlAllocClassTest, PMEMOBJ_CTL_CLASS_WITH_SAME_DESC) {
   EXPECT_EQ(-1, pmemobj_ctl_set(pop, "heap.alloc_class.130.desc", &write_arg));
   EXPECT_EQ(EINVAL, errno);
   /* Step 8 */
-  pmemobj_close(pop);
+  ReleasePool();
 }
 
 /**
  * PMEMOBJ_CTL_OVERWRITE_CUSTOM_CLASS
  * Overwriting custom allocation class
  * \test
- *          \li \c Step1. Create pmemobj pool / SUCCESS
+ *          \li \c Step1. Acquire pristine pmemobj pool / SUCCESS
  *          \li \c Step2. Create allocation class with an id of 128 / SUCCESS
  *          \li \c Step3. Create allocation class with an id of 128 /
  *          FAIL: ret = -1, errno = EEXIST
- *          \li \c Step4. Close pool / SUCCESS
+ *          \li \c Step4. Release pool / SUCCESS
  */
 TEST_F(ObjCtlAllocClassTest, PMEMOBJ_CTL_OVERWRITE_CUSTOM_CLASS) {
   /* Step 1 */
-  PMEMobjpool *pop =
-      pmemobj_create(pool_path_.c_str(), nullptr, PMEMOBJ_MIN_POOL, 0666);
+  PMEMobjpool *pop = AcquirePool();
   ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
   /* Step 2 */
   pobj_alloc_class_desc write_arg;
@@ -116,25 +115,24 @@ TEST_F(ObjCtlAllocClassTest, PMEMOBJ_CTL_OVERWRITE_CUSTOM_CLASS) {
   EXPECT_EQ(-1, pmemobj_ctl_set(pop, "heap.alloc_class.128.desc", &write_arg));
   EXPECT_EQ(EEXIST, errno);
   /* Step 4 */
-  pmemobj_close(pop);
+  ReleasePool();
 }
 
 /**
  * PMEMOBJ_CTL_SET_ALL_ALLOCATION_CLASSES
  * Creating maximum number of allocation classes
  * \test
- *          \li \c Step1. Create pmemobj pool / SUCCESS
+ *          \li \c Step1. Acquire pristine pmemobj pool / SUCCESS
  *          \li \c Step2. Count number of available class ids
  *          \li \c Step3. Create all available allocation classes automatically
  *          / SUCCESS
  *          \li \c Step4. Retrieve information about all allocation classes
  *          / SUCCESS
- *          \li \c Step5. Close pool / SUCCESS
+ *          \li \c Step5. Release pool / SUCCESS
  */
 TEST_F(ObjCtlAllocClassTest, PMEMOBJ_CTL_SET_ALL_ALLOCATION_CLASSES) {
   /* Step 1 */
-  PMEMobjpool *pop =
-      pmemobj_create(pool_path_.c_str(), nullptr, PMEMOBJ_MIN_POOL, 0666);
+  PMEMobjpool *pop = AcquirePool();
   ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
   /* Step 2 */
   int free_ids = 0;
@@ -166,23 +164,22 @@ TEST_F(ObjCtlAllocClassTest, PMEMOBJ_CTL_SET_ALL_ALLOCATION_CLASSES) {
         << pmemobj_errormsg();
   }
   /* Step 5 */
-  pmemobj_close(pop);
+  ReleasePool();
 }
 
 /**
  * PMEMOBJ_CTL_ALLOCATE_FROM_UNEXISTING_CLASS
  * Allocating objects from unexisting allocation classes with ids: 128, 254
  * \test
- *          \li \c Step1. Create pmemobj pool / SUCCESS
+ *          \li \c Step1. Acquire pristine pmemobj pool / SUCCESS
  *          \li \c Step2. Allocate an object from the allocation class
  *          / FAIL: ret = -1, errno = EINVAL
  *          \li \c Step3. Make sure object is not allocated
- *          \li \c Step4. Close pool / SUCCESS
+ *          \li \c Step4. Release pool / SUCCESS
  */
 TEST_F(ObjCtlAllocClassTest, PMEMOBJ_CTL_ALLOCATE_FROM_UNEXISTING_CLASS) {
   /* Step 1 */
-  PMEMobjpool *pop =
-      pmemobj_create(pool_path_.c_str(), nullptr, PMEMOBJ_MIN_POOL, 0666);
+  PMEMobjpool *pop = AcquirePool();
   ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
   /* Step 2 */
   PMEMoid oid = OID_NULL;
@@ -196,14 +193,62 @@ TEST_F(ObjCtlAllocClassTest, PMEMOBJ_CTL_ALLOCATE_FROM_UNEXISTING_CLASS) {
     EXPECT_TRUE(OID_IS_NULL(oid));
   }
   /* Step 4 */
-  pmemobj_close(pop);
+  ReleasePool();
+}
+
+/**
+ * PERF_PMEMOBJ_CTL_COMPACT_CLASS_ALLOC_THROUGHPUT
+ * Throughput of allocating and freeing objects from allocation class of
+ * 128-byte units with compact header. Gate threshold (Mops/s) named
+ * PMEMOBJ_CTL_COMPACT_128_ALLOC is taken from config.xml or baseline file;
+ * without it throughput is only reported. Run only if selected explicitly,
+ * e.g. --gtest_filter=*PERF_*
+ * \test
+ *          \li \c Step1. Acquire pristine pmemobj pool / SUCCESS
+ *          \li \c Step2. Create allocation class with unit size of 128 bytes
+ *          and compact header / SUCCESS
+ *          \li \c Step3. Allocate and free object from the class repeatedly
+ *          / SUCCESS, throughput is not below the threshold
+ *          \li \c Step4. Release pool / SUCCESS
+ */
+TEST_F(ObjCtlAllocClassTest, PERF_PMEMOBJ_CTL_COMPACT_CLASS_ALLOC_THROUGHPUT) {
+  /* Step 1 */
+  PMEMobjpool *pop = AcquirePool();
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+  /* Step 2 */
+  pobj_alloc_class_desc write_arg;
+  write_arg.unit_size = 128;
+  write_arg.alignment = 0;
+  write_arg.units_per_block = 1000;
+  write_arg.header_type = POBJ_HEADER_COMPACT;
+  ASSERT_EQ(0, pmemobj_ctl_set(pop, "heap.alloc_class.new.desc", &write_arg))
+      << pmemobj_errormsg();
+  /* Step 3 */
+  const size_t size =
+      write_arg.unit_size - AllocClassUtils::hdrs[POBJ_HEADER_COMPACT].size;
+  int failures = 0;
+  auto alloc_free = [&]() {
+    PMEMoid oid = OID_NULL;
+    if (pmemobj_xalloc(pop, &oid, size, 0, POBJ_CLASS_ID(write_arg.class_id),
+                       nullptr, nullptr) != 0) {
+      ++failures;
+      return;
+    }
+    pmemobj_free(&oid);
+  };
+  EXPECT_THROUGHPUT_GE(local_config->GetPerfThresholds(),
+                       "PMEMOBJ_CTL_COMPACT_128_ALLOC", alloc_free,
+                       perf_assert::PerfOptions());
+  EXPECT_EQ(0, failures) << pmemobj_errormsg();
+  /* Step 4 */
+  ReleasePool();
 }
 
 /**
  * PMEMOBJ_CTL_ALLOCATE_FROM_CLASS
  * Allocating objects from allocation classes
  * \test
- *          \li \c Step1. Create pmemobj pool / SUCCESS
+ *          \li \c Step1. Acquire pristine pmemobj pool / SUCCESS
  *          \li \c Step2. Retrieve information about class of id = 1 / SUCCESS
  *          \li \c Step3. Allocate an object from the allocation class with an
  *          id equal to 0 / SUCCESS
@@ -213,12 +258,11 @@ TEST_F(ObjCtlAllocClassTest, PMEMOBJ_CTL_ALLOCATE_FROM_UNEXISTING_CLASS) {
  *          \li \c Step7. Allocate an object from created allocation class
  *          / SUCCESS
  *          \li \c Step8. Make sure object is allocated
- *          \li \c Step9. Close pool / SUCCESS
+ *          \li \c Step9. Release pool / SUCCESS
  */
 TEST_F(ObjCtlAllocClassTest, PMEMOBJ_CTL_ALLOCATE_FROM_CLASS) {
   /* Step 1 */
-  PMEMobjpool *pop =
-      pmemobj_create(pool_path_.c_str(), nullptr, PMEMOBJ_MIN_POOL, 0666);
+  PMEMobjpool *pop = AcquirePool();
   ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
   /* Step 2 */
   PMEMoid oid = OID_NULL;
@@ -255,7 +299,7 @@ TEST_F(ObjCtlAllocClassTest, PMEMOBJ_CTL_ALLOCATE_FROM_CLASS) {
   EXPECT_FALSE(OID_IS_NULL(oid));
   pmemobj_free(&oid);
   /* Step 9 */
-  pmemobj_close(pop);
+  ReleasePool();
 }
 
 /**
@@ -266,20 +310,19 @@ TEST_F(ObjCtlAllocClassTest, PMEMOBJ_CTL_ALLOCATE_FROM_CLASS) {
  * - POBJ_HEADER_LEGACY / type numbers supported
  * - POBJ_HEADER_COMPACT / type numbers supported
  * \test
- *          \li \c Step1. Create pmemobj pool / SUCCESS
+ *          \li \c Step1. Acquire pristine pmemobj pool / SUCCESS
  *          \li \c Step2. Create allocation class / SUCCESS
  *          \li \c Step3. Allocate an object from the allocation class with type
  *          number equal to 1 / SUCCESS
  *          \li \c Step4. Make sure object is allocated
  *          \li \c Step5. Get type number of the allocated object
  *          \li \c Step6. Make sure valid type number is returned
- *          \li \c Step7. Close pool / SUCCESS
+ *          \li \c Step7. Release pool / SUCCESS
  */
 TEST_P(ObjCtlAllocateFromCustomAllocClassParamTest,
        PMEMOBJ_CTL_CHECK_HDR_TYPE_NUM_SUPPORT) {
   /* Step 1 */
-  PMEMobjpool *pop =
-      pmemobj_create(pool_path_.c_str(), nullptr, PMEMOBJ_MIN_POOL, 0666);
+  PMEMobjpool *pop = AcquirePool();
   ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
   /* Step 2 */
   pobj_alloc_class_desc write_arg;
@@ -310,7 +353,7 @@ TEST_P(ObjCtlAllocateFromCustomAllocClassParamTest,
   }
   pmemobj_free(&oid);
   /* Step 7 */
-  pmemobj_close(pop);
+  ReleasePool();
 }
 
 INSTANTIATE_TEST_CASE_P(DifferentHdrType,
@@ -329,7 +372,7 @@ INSTANTIATE_TEST_CASE_P(DifferentHdrType,
  * - POBJ_HEADER_LEGACY / 64-byte header, allocation can span up to 64 units
  * - POBJ_HEADER_COMPACT / 16-byte header, allocation can span up to 64 units
  * \test
- *          \li \c Step1. Create pmemobj pool / SUCCESS
+ *          \li \c Step1. Acquire pristine pmemobj pool / SUCCESS
  *          \li \c Step2. Create allocation class / SUCCESS
  *          \li \c Step3. Retrieve information about allocation class
  *          / SUCCESS
@@ -346,13 +389,12 @@ INSTANTIATE_TEST_CASE_P(DifferentHdrType,
  *          \li \c Step10. Allocate an object of size greater than max possible
  *          size from the allocation class / FAIL: ret = -1, errno = EINVAL
  *          \li \c Step11. Make sure object is not allocated
- *          \li \c Step12. Close pool / SUCCESS
+ *          \li \c Step12. Release pool / SUCCESS
  */
 TEST_P(ObjCtlAllocateFromCustomAllocClassParamTest2,
        PMEMOBJ_CTL_CHECK_HDR_METADATA) {
   /* Step 1 */
-  PMEMobjpool *pop =
-      pmemobj_create(pool_path_.c_str(), nullptr, PMEMOBJ_MIN_POOL, 0666);
+  PMEMobjpool *pop = AcquirePool();
   ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
   /* Step 2 */
   PMEMoid oid = OID_NULL;
@@ -409,7 +451,7 @@ TEST_P(ObjCtlAllocateFromCustomAllocClassParamTest2,
   /* Step 11 */
   EXPECT_TRUE(OID_IS_NULL(oid));
   /* Step 12 */
-  pmemobj_close(pop);
+  ReleasePool();
 }
 
 INSTANTIATE_TEST_CASE_P(
@@ -451,22 +493,24 @@ INSTANTIATE_TEST_CASE_P(
  * - Retrieve information from unexisting class (class of id = 128) - GET
  *   / FAIL: ret = -1, errno = ENOENT
  * \test
- *          \li \c Step1. Create pmemobj pool / SUCCESS
+ *          \li \c Step1. Acquire pristine pmemobj pool, or pool shared with
+ *          other GET scenarios / SUCCESS
  *          \li \c Step2. Execute scenario
  *          \li \c Step3. Allocate an object from allocation class, check
  *          object's alignment if custom alignment was set
- *          \li \c Step4. Close pool
+ *          \li \c Step4. Release pool if it is not shared
  */
 TEST_P(ObjCtlAllocClassParamTest, PMEMOBJ_CTL_CUSTOM_ALLOCATION_CLASS) {
   /* Step 1 */
   size_t pool_size = PMEMOBJ_MIN_POOL;
-  PMEMobjpool *pop =
-      pmemobj_create(pool_path_.c_str(), nullptr, pool_size, 0666);
-  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
-  /* Step 2 */
   in_args i_args;
   out_args o_args;
   tie(i_args, o_args) = GetParam();
+  /* failing SET may still leave a partially registered class behind */
+  bool shared = i_args.scenario == Scenario::GET;
+  PMEMobjpool *pop = shared ? obj_pools->GetShared() : AcquirePool();
+  ASSERT_TRUE(pop != nullptr) << pmemobj_errormsg();
+  /* Step 2 */
 
   string entry_point =
       "heap.alloc_class." + to_string(i_args.write_args.class_id) + ".desc";
@@ -506,7 +550,9 @@ TEST_P(ObjCtlAllocClassParamTest, PMEMOBJ_CTL_CUSTOM_ALLOCATION_CLASS) {
     }
   }
   /* Step 4 */
-  pmemobj_close(pop);
+  if (!shared) {
+    ReleasePool();
+  }
 }
 
 INSTANTIATE_TEST_CASE_P(
@@ -32,6 +32,22 @@
 
 #include "ext_cfg.h"
 #include "api_c/api_c.h"
+#include "test_utils/test_dir.h"
+
+ObjCtlExtCfgTest::ObjCtlExtCfgTest() {
+  const ::testing::TestInfo *info =
+      ::testing::UnitTest::GetInstance()->current_test_info();
+  std::string test_name = std::string(info->test_case_name()) + "." +
+                          std::string(info->name());
+
+  if (test_utils::CreateTestDir(local_config->GetTestDir(), test_name,
+                                test_dir_) != 0) {
+    ADD_FAILURE() << "Cannot create directory for test " << test_name;
+  }
+
+  pool_path_ = test_dir_ + "pool";
+  cfg_file_path_ = test_dir_ + "cfg_file";
+}
 
 void ObjCtlExtCfgTest::SetUp() {
   errno = 0;
@@ -51,14 +67,7 @@ void ObjCtlExtCfgTest::SetUp() {
 
 void ObjCtlExtCfgTest::TearDown() {
   ApiC::UnsetEnv(env_var_);
-  if (scenario_ == ExternalCfg::FROM_CFG_FILE) {
-    ApiC::RemoveFile(cfg_file_path_);
-  }
-}
-
-void ObjCtlExtCfgPosTest::TearDown() {
-  ApiC::RemoveFile(pool_path_);
-  ObjCtlExtCfgTest::TearDown();
+  test_utils::RemoveTestDir(test_dir_);
 }
 
 std::string ObjCtlExtCfgTest::ToCtlString(
@@ -51,13 +51,15 @@ enum class ExternalCfg { FROM_ENV_VAR, FROM_CFG_FILE };
 class ObjCtlExtCfgTest : public ::testing::TestWithParam<
                              std::tuple<pobj_alloc_class_desc, ExternalCfg>> {
  private:
-  std::string test_dir_ = local_config->GetTestDir();
+  /* directory unique for the test instance, removed after the test */
+  std::string test_dir_;
 
  public:
   std::string env_var_;
   ExternalCfg scenario_;
-  std::string pool_path_ = test_dir_ + "pool";
-  std::string cfg_file_path_ = test_dir_ + "cfg_file";
+  std::string pool_path_;
+  std::string cfg_file_path_;
+  ObjCtlExtCfgTest();
   pobj_alloc_class_desc write_arg_;
   /* ToCtlString -- returns valid alloc class query string based on desc struct
    */
@@ -72,10 +74,7 @@ class ObjCtlExtCfgTest : public ::testing::TestWithParam<
   virtual void TearDown();
 };
 
-class ObjCtlExtCfgPosTest : public ObjCtlExtCfgTest {
- public:
-  void TearDown() override;
-};
+class ObjCtlExtCfgPosTest : public ObjCtlExtCfgTest {};
 
 class ObjCtlExtCfgNegTest : public ObjCtlExtCfgTest {};
 
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "obj_pool_provider.h"
+
+int ObjPoolProvider::PreparePool(const std::string &path) {
+  if (!ApiC::DirectoryExists(dir_) && ApiC::CreateDirectoryT(dir_) != 0) {
+    return -1;
+  }
+
+  return image_cache_.GetPool(
+      "obj " + std::to_string(pool_size_), {path}, [&]() {
+        PMEMobjpool *pop =
+            pmemobj_create(path.c_str(), nullptr, pool_size_, 0666);
+        if (pop == nullptr) {
+          std::cerr << pmemobj_errormsg() << std::endl;
+          return -1;
+        }
+        pmemobj_close(pop);
+        return 0;
+      });
+}
+
+ObjPoolProvider::~ObjPoolProvider() {
+  if (shared_pop_ != nullptr) {
+    pmemobj_close(shared_pop_);
+  }
+
+  for (const auto &pool : acquired_) {
+    pmemobj_close(pool.first);
+  }
+
+  image_cache_.Clear();
+
+  if (ApiC::DirectoryExists(dir_)) {
+    ApiC::CleanDirectory(dir_);
+    ApiC::RemoveDirectoryT(dir_);
+  }
+}
+
+PMEMobjpool *ObjPoolProvider::Acquire() {
+  std::string path;
+
+  if (pristine_.empty()) {
+    path = dir_ + "pool" + std::to_string(pool_counter_++);
+    if (PreparePool(path) != 0) {
+      return nullptr;
+    }
+  } else {
+    path = pristine_.back();
+    pristine_.pop_back();
+  }
+
+  PMEMobjpool *pop = pmemobj_open(path.c_str(), nullptr);
+
+  if (pop == nullptr) {
+    std::cerr << pmemobj_errormsg() << std::endl;
+    ApiC::RemoveFile(path);
+    return nullptr;
+  }
+
+  acquired_.emplace(pop, path);
+  return pop;
+}
+
+int ObjPoolProvider::Release(PMEMobjpool *pop) {
+  auto it = acquired_.find(pop);
+
+  if (it == acquired_.end()) {
+    std::cerr << "Pool was not acquired from provider" << std::endl;
+    return -1;
+  }
+
+  std::string path = it->second;
+  acquired_.erase(it);
+  pmemobj_close(pop);
+
+  if (PreparePool(path) != 0) {
+    ApiC::RemoveFile(path);
+    return -1;
+  }
+
+  pristine_.emplace_back(path);
+  return 0;
+}
+
+PMEMobjpool *ObjPoolProvider::GetShared() {
+  if (shared_pop_ != nullptr) {
+    return shared_pop_;
+  }
+
+  std::string path = dir_ + "shared_pool";
+
+  if (PreparePool(path) != 0) {
+    return nullptr;
+  }
+
+  shared_pop_ = pmemobj_open(path.c_str(), nullptr);
+
+  if (shared_pop_ == nullptr) {
+    std::cerr << pmemobj_errormsg() << std::endl;
+  }
+
+  return shared_pop_;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_TESTS_PMEMOBJ_UTILS_OBJ_POOL_PROVIDER_H_
+#define PMDK_TESTS_SRC_TESTS_PMEMOBJ_UTILS_OBJ_POOL_PROVIDER_H_
+
+#include <libpmemobj.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "non_copyable/non_copyable.h"
+#include "pool_cache/pool_image_cache.h"
+
+/*
+ * ObjPoolProvider -- hands out pmemobj pools to tests. Pool files are kept
+ * between tests and restored to pristine state by cloning the image of pool
+ * created on first request instead of being recreated. Tests which do not
+ * modify the pool may share single pool opened for the whole test run.
+ */
+class ObjPoolProvider final : NonCopyable {
+ private:
+  std::string dir_;
+  size_t pool_size_;
+  PoolImageCache image_cache_;
+  std::vector<std::string> pristine_;
+  std::map<PMEMobjpool *, std::string> acquired_;
+  unsigned pool_counter_ = 0;
+  PMEMobjpool *shared_pop_ = nullptr;
+
+  int PreparePool(const std::string &path);
+
+ public:
+  ObjPoolProvider(const std::string &dir, size_t pool_size)
+      : dir_(dir),
+        pool_size_(pool_size),
+        image_cache_(GetImagesDir(dir)) {
+  }
+  ~ObjPoolProvider();
+
+  /*
+   * GetImagesDir -- returns directory inside provider's directory, where
+   * golden pool images are kept.
+   */
+  static std::string GetImagesDir(const std::string &dir) {
+    return dir + "images" + SEPARATOR;
+  }
+
+  /*
+   * Acquire -- returns opened pristine pool which test may modify. Returns
+   * nullptr on failure.
+   */
+  PMEMobjpool *Acquire();
+
+  /*
+   * Release -- closes pool returned by Acquire and restores its pristine
+   * state, so that it can be handed out again. Returns 0 on success, prints
+   * error message and returns -1 otherwise.
+   */
+  int Release(PMEMobjpool *pop);
+
+  /*
+   * GetShared -- returns pool opened once and shared by tests, which do not
+   * modify the pool nor its runtime state. Shared pool must not be closed by
+   * the test. Returns nullptr on failure.
+   */
+  PMEMobjpool *GetShared();
+};
+
+#endif  // !PMDK_TESTS_SRC_TESTS_PMEMOBJ_UTILS_OBJ_POOL_PROVIDER_H_
@@ -35,8 +35,18 @@
 #include <memory>
 #include "configXML/local_configuration.h"
 #include "gtest/gtest.h"
+#include "pool_cache/pool_image_cache.h"
+#include "structures.h"
+#include "test_utils/test_dir.h"
+#include "test_utils/test_supervisor.h"
+#include "test_utils/timing_listener.h"
 
 std::unique_ptr<LocalConfiguration> local_config{new LocalConfiguration()};
+std::unique_ptr<PoolImageCache> pool_cache;
+
+/* test creates at most pool and pool it inherits settings from, image cache
+ * keeps golden copy of both */
+const unsigned long long POOLS_SPACE = 4 * struct_utils::GetMaxPoolSize();
 
 int main(int argc, char **argv) {
   int ret = 0;
@@ -44,16 +54,47 @@ int main(int argc, char **argv) {
     if (local_config->ReadConfigFile() != 0) {
       return -1;
     }
+    if (local_config->CheckEmulatedPmemCapacity(POOLS_SPACE) != 0) {
+      return -1;
+    }
+
+    /* test processes sharing test directory keep separate image caches */
+    pool_cache.reset(new PoolImageCache(
+        test_utils::GetProcessDir(local_config->GetTestDir(), "cache")));
 
     ::testing::InitGoogleTest(&argc, argv);
-    ret = RUN_ALL_TESTS();
+    if (TimingListener::Install(argc, argv) != 0) {
+      return -1;
+    }
+    std::cout << "Persistent memory mode: " << local_config->GetPmemMode()
+              << std::endl;
+    ::testing::Test::RecordProperty("pmem_mode", local_config->GetPmemMode());
+    TestSupervisor supervisor;
+    if (supervisor.ParseArguments(argc, argv) != 0) {
+      return -1;
+    }
+    /* images stored by one child are unknown to the next one */
+    supervisor.SetChildSetup([]() {
+      pool_cache.reset(new PoolImageCache(
+          test_utils::GetProcessDir(local_config->GetTestDir(), "cache")));
+      return 0;
+    });
+    supervisor.SetChildCleanup([](unsigned long pid) {
+      PoolImageCache(test_utils::GetProcessDir(local_config->GetTestDir(),
+                                               "cache", pid))
+          .Clear();
+    });
+    ret = supervisor.Run();
   } catch (const std::exception &e) {
     std::cerr << "Exception was caught: " << e.what() << std::endl;
     ret = -1;
   }
 
-  ApiC::CleanDirectory(local_config->GetTestDir());
-  ApiC::RemoveDirectoryT(local_config->GetTestDir());
+  if (pool_cache) {
+    pool_cache->Clear();
+  }
+  /* each test removes its own directory, other test processes may still run */
+  test_utils::RemoveDirectoryIfEmpty(local_config->GetTestDir());
 
   return ret;
 }
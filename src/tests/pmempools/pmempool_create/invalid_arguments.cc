@@ -38,8 +38,9 @@ void InvalidArgumentsTests::SetUp() {
 
 void InvalidInheritTests::SetUp() {
   pool_inherit = GetParam();
+  pool_inherit.pool_inherited = Rebase(pool_inherit.pool_inherited);
 
-  ASSERT_EQ(0, CreatePool(pool_inherit.pool_base, pool_path_))
+  ASSERT_EQ(0, GetPool(pool_inherit.pool_base, pool_path_))
       << GetOutputContent();
   ASSERT_EQ(0,
             file_utils::ValidateFile(
@@ -48,7 +49,7 @@ void InvalidInheritTests::SetUp() {
 }
 
 void InvalidArgumentsPoolsetTests::SetUp() {
-  poolset_args = GetParam();
+  poolset_args = Rebase(GetParam());
 
   ASSERT_EQ(0, p_mgmt_.CreatePoolsetFile(poolset_args.poolset));
 }
@@ -32,6 +32,21 @@
 
 #include "pmempool_create.h"
 
+PmempoolCreate::PmempoolCreate() {
+  const ::testing::TestInfo *info =
+      ::testing::UnitTest::GetInstance()->current_test_info();
+  std::string test_name = std::string(info->test_case_name()) + "." +
+                          std::string(info->name());
+
+  if (test_utils::CreateTestDir(local_config->GetTestDir(), test_name,
+                                test_dir_) != 0) {
+    ADD_FAILURE() << "Cannot create directory for test " << test_name;
+  }
+
+  pool_path_ = test_dir_ + "pool.file";
+  inherit_file_path_ = test_dir_ + "inherited.pool";
+}
+
 int PmempoolCreate::CreatePool(const PoolArgs &pool_args,
                                const std::string &path) {
   std::string create_args =
@@ -43,6 +58,44 @@ int PmempoolCreate::CreatePool(const PoolArgs &pool_args,
   return output_.GetExitCode();
 }
 
+int PmempoolCreate::GetPool(const PoolArgs &pool_args,
+                            const std::string &path) {
+  bool created = false;
+  int ret = pool_cache->GetPool(struct_utils::GetPoolKey(pool_args), {path},
+                                [&]() {
+                                  created = true;
+                                  return CreatePool(pool_args, path);
+                                });
+
+  /* output of pmempool run for earlier test would be misleading */
+  if (!created) {
+    std::string msg = ret == 0 ? "Pool cloned from image cache: "
+                               : "Cannot clone pool from image cache: ";
+    output_ = Output<>(ret, msg + path);
+  }
+
+  return ret;
+}
+
+PoolArgs PmempoolCreate::Rebase(const PoolArgs &pool_args) const {
+  const std::string &shared_dir = local_config->GetTestDir();
+  PoolArgs rebased = pool_args;
+
+  for (auto &arg : rebased.args) {
+    if (arg.option == Option::Inherit &&
+        arg.value.compare(0, shared_dir.size(), shared_dir) == 0) {
+      arg.value = test_dir_ + arg.value.substr(shared_dir.size());
+    }
+  }
+
+  return rebased;
+}
+
+PoolsetArgs PmempoolCreate::Rebase(const PoolsetArgs &poolset_args) const {
+  return PoolsetArgs{Rebase(poolset_args.args),
+                     poolset_args.poolset.Rebase(test_dir_)};
+}
+
 void PmempoolCreate::TearDown() {
-  api_c_.CleanDirectory(local_config->GetTestDir());
+  test_utils::RemoveTestDir(test_dir_);
 }
@@ -36,11 +36,14 @@
 #include "configXML/local_configuration.h"
 #include "gtest/gtest.h"
 #include "output/output.h"
+#include "pool_cache/pool_image_cache.h"
 #include "shell/i_shell.h"
 #include "structures.h"
 #include "test_utils/file_utils.h"
+#include "test_utils/test_dir.h"
 
 extern std::unique_ptr<LocalConfiguration> local_config;
+extern std::unique_ptr<PoolImageCache> pool_cache;
 
 class PmempoolCreate : public ::testing::Test {
  private:
@@ -51,9 +54,12 @@ class PmempoolCreate : public ::testing::Test {
   ApiC api_c_;
   IShell shell_;
   PoolsetManagement p_mgmt_;
-  const std::string pool_path_ = local_config->GetTestDir() + "pool.file";
-  const std::string inherit_file_path_ =
-      local_config->GetTestDir() + "inherited.pool";
+  /* directory unique for the test instance, removed after the test */
+  std::string test_dir_;
+  std::string pool_path_;
+  std::string inherit_file_path_;
+
+  PmempoolCreate();
 
   const std::string &GetOutputContent() const {
     return output_.GetContent();
@@ -66,6 +72,28 @@ class PmempoolCreate : public ::testing::Test {
    */
   int CreatePool(const PoolArgs &pool_args, const std::string &path);
 
+  /*
+   * GetPool -- places pool created with given arguments in given path. Pool is
+   * cloned from the image cache if the same pool was already created during
+   * the test run. Intended for tests that need a valid pool rather than
+   * testing its creation. Output is assigned as by CreatePool, or describes
+   * the clone if the pool was cloned. Returns 0 on success, -1 otherwise.
+   */
+  int GetPool(const PoolArgs &pool_args, const std::string &path);
+
+  /*
+   * Rebase -- returns copy of pool arguments with paths given in shared test
+   * directory (e.g. of pool to inherit settings from) moved to directory of
+   * the test instance.
+   */
+  PoolArgs Rebase(const PoolArgs &pool_args) const;
+
+  /*
+   * Rebase -- returns copy of pool set arguments with pool set file and its
+   * parts moved from shared test directory to directory of the test instance.
+   */
+  PoolsetArgs Rebase(const PoolsetArgs &poolset_args) const;
+
   virtual void TearDown();
 };
 
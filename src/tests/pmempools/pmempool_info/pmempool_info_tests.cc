@@ -0,0 +1,121 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "pmempool_info.h"
+
+/**
+ * PmempoolInfoParam.PMEMPOOL_INFO_HEADERS
+ * Validating layout fields of pools of different type printed by pmempool info
+ * \test
+ *          \li \c Step1. Run pmempool info on the pool / SUCCESS
+ *          \li \c Step2. Make sure that pool header has signature of pool type
+ * and valid checksum
+ *          \li \c Step3. Make sure that pool type specific header matches
+ * arguments the pool was created with and fits in the pool
+ */
+TEST_P(PmempoolInfo, PMEMPOOL_INFO_HEADERS) {
+  const unsigned long long pool_size = struct_utils::GetPoolSize(pool_args);
+
+  /* Step 1 */
+  ASSERT_EQ(0, RunInfo("", pool_path_)) << GetInfoOutputContent();
+  /* Step 2 */
+  PoolHeaderInfo pool_header;
+  ASSERT_EQ(0, info.GetPoolHeader(pool_header));
+  EXPECT_TRUE(pool_header.checksum_ok);
+  /* Step 3 */
+  switch (pool_args.pool_type) {
+    case PoolType::Obj: {
+      EXPECT_TRUE(pool_header.signature == "PMEMOBJ");
+      ObjHeaderInfo obj_header;
+      ASSERT_EQ(0, info.GetObjHeader(obj_header));
+      EXPECT_TRUE(obj_header.layout == "info_layout");
+      EXPECT_LT(0u, obj_header.nlanes);
+      EXPECT_LE(obj_header.heap_offset + obj_header.heap_size, pool_size);
+      break;
+    }
+    case PoolType::Blk: {
+      EXPECT_TRUE(pool_header.signature == "PMEMBLK");
+      BlkHeaderInfo blk_header;
+      ASSERT_EQ(0, info.GetBlkHeader(blk_header));
+      EXPECT_EQ(4096u, blk_header.block_size);
+      break;
+    }
+    case PoolType::Log: {
+      EXPECT_TRUE(pool_header.signature == "PMEMLOG");
+      LogHeaderInfo log_header;
+      ASSERT_EQ(0, info.GetLogHeader(log_header));
+      EXPECT_LT(log_header.start_offset, log_header.end_offset);
+      EXPECT_LE(log_header.end_offset, pool_size);
+      EXPECT_EQ(log_header.start_offset, log_header.write_offset);
+      break;
+    }
+    default:
+      FAIL() << "Unexpected pool type";
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    PmempoolInfoParam, PmempoolInfo,
+    ::testing::Values(
+        PoolArgs{PoolType::Obj,
+                 {{Option::Layout, OptionType::Long, "info_layout"}}},
+        PoolArgs{PoolType::Blk, {{Option::BSize, OptionType::Long, "4096"}}},
+        PoolArgs{PoolType::Log}));
+
+class PmempoolInfoObj : public PmempoolInfo {};
+
+/**
+ * PmempoolInfoObjParam.PMEMPOOL_INFO_ZONES
+ * Validating heap zones of pmemobj pool printed by pmempool info
+ * \test
+ *          \li \c Step1. Run pmempool info with --heap and --zones options on
+ * the pool / SUCCESS
+ *          \li \c Step2. Make sure that all zones have valid magic and non-zero
+ * size
+ */
+TEST_P(PmempoolInfoObj, PMEMPOOL_INFO_ZONES) {
+  /* Step 1 */
+  ASSERT_EQ(0, RunInfo("--heap --zones ", pool_path_))
+      << GetInfoOutputContent();
+  /* Step 2 */
+  std::vector<ZoneInfo> zones;
+  ASSERT_EQ(0, info.GetZones(zones)) << GetInfoOutputContent();
+  for (const auto &zone : zones) {
+    EXPECT_EQ(ZONE_HEADER_MAGIC, zone.magic) << "zone " << zone.index;
+    EXPECT_LT(0u, zone.size_idx) << "zone " << zone.index;
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    PmempoolInfoObjParam, PmempoolInfoObj,
+    ::testing::Values(PoolArgs{PoolType::Obj,
+                               {{Option::Size, OptionType::Long, "64M"}}}));
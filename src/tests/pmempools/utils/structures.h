@@ -46,6 +46,8 @@ enum class PoolType { Obj, Blk, Log, None, Count };
 
 enum class OptionType { Long, Short, ShortNoSpace };
 
+enum class Subcommand { Create, Info, Check, Dump, Rm, Convert, Count };
+
 enum class Option {
   Size,
   MaxSize,
@@ -126,6 +128,9 @@ static inline constexpr RetType ConvertEnum(EnumType t) {
 const std::array<std::string, ConvertEnum<int>(PoolType::Count)> POOL_TYPES{
     {"obj ", "blk ", "log ", ""}};
 
+const std::array<std::string, ConvertEnum<int>(Subcommand::Count)> SUBCOMMANDS{
+    {"create ", "info ", "check ", "dump ", "rm ", "convert "}};
+
 const std::array<std::string, ConvertEnum<int>(Option::Count)> LONG_OPTIONS{
     {"--size ", "--max-size ", "--mode ", "--inherit ", "--force ",
      "--verbose ", "--help ", "--write-layout", "", "--layout "}};
@@ -173,6 +178,15 @@ static inline std::string CombineArguments(const std::vector<Arg> &args) {
   return arguments;
 }
 
+/*
+ * GetPoolKey -- returns string which identifies pool created with given
+ * arguments.
+ */
+static inline std::string GetPoolKey(const PoolArgs &pool_args) {
+  return POOL_TYPES[ConvertEnum<int>(pool_args.pool_type)] +
+         CombineArguments(pool_args.args);
+}
+
 /*
  * GetPoolSize -- returns size of the pool in bytes. If size argument is not
  * specified in PoolArgs returns PMEM<pool type>MIN_POOL.
@@ -196,6 +210,22 @@ static inline size_t GetPoolSize(const PoolArgs &pool_args) {
   return POOL_MIN_SIZES[ConvertEnum<int>(pool_args.pool_type)];
 }
 
+/*
+ * GetMaxPoolSize -- returns size of the largest pool created by tests, i.e.
+ * the largest of pool sizes given in arguments of tests and minimal pool
+ * sizes.
+ */
+static inline size_t GetMaxPoolSize() {
+  size_t max_size =
+      *std::max_element(POOL_MIN_SIZES.begin(), POOL_MIN_SIZES.end());
+
+  for (const auto &size : SIZES_MiB) {
+    max_size = std::max(max_size, size.second);
+  }
+
+  return max_size;
+}
+
 /*
  * GetPoolMode -- returns mode of the pool in decimal. If mode argument is not
  * specified it returns
@@ -36,6 +36,7 @@
 #include "inject_mananger/inject_manager.h"
 #include "local_test_phase.h"
 #include "shell/i_shell.h"
+#include "test_utils/timing_listener.h"
 
 bool PartiallyPassed() {
   ::testing::UnitTest *ut = ::testing::UnitTest::GetInstance();
@@ -46,6 +47,9 @@ int main(int argc, char **argv) {
   int ret = 0;
   try {
     ::testing::InitGoogleTest(&argc, argv);
+    if (TimingListener::Install(argc, argv) != 0) {
+      return 1;
+    }
     LocalTestPhase &test_phase = LocalTestPhase::GetInstance();
     test_phase.ParseCmdArgs(argc, argv);
 
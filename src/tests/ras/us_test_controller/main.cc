@@ -34,6 +34,7 @@
 #include "exit_codes.h"
 #include "gtest/gtest.h"
 #include "ras_configuration.h"
+#include "test_utils/timing_listener.h"
 
 std::unique_ptr<std::string> gtest_filter{new std::string{}};
 std::unique_ptr<RASConfigurationCollection> ras_config{
@@ -46,6 +47,9 @@ int main(int argc, char** argv) {
     }
 
     ::testing::InitGoogleTest(&argc, argv);
+    if (TimingListener::Install(argc, argv) != 0) {
+      return -1;
+    }
 
     /* Pass gtest_filter to managed test binary */
     gtest_filter->assign(::testing::GTEST_FLAG(filter));
@@ -129,6 +129,7 @@ ndctl_interleave_set *DimmNamespace::GetInterleaveSet(ndctl_ctx *ctx,
     }
 
     if (dev == stat.st_rdev) {
+      numa_node_ = ndctl_namespace_get_numa_node(ndns);
       return ndctl_region_get_interleave_set(region);
     }
   }
@@ -169,6 +170,10 @@ DimmNamespace::DimmNamespace(const std::string &mountpoint) {
     dimms_.emplace_back(Dimm{dimm, dimm_uid});
   }
 
+  if (numa_node_ < 0) {
+    numa_node_ = ApiC::GetNumaNode(mountpoint);
+  }
+
   if (!is_dax_) {
     test_dir_ = mountpoint + SEPARATOR + "pmdk_tests" + SEPARATOR;
     if (!ApiC::DirectoryExists(test_dir_) &&
@@ -58,6 +58,7 @@ class Dimm final {
 class DimmNamespace final {
  private:
   bool is_dax_ = false;
+  int numa_node_ = -1;
   std::string test_dir_;
   std::vector<Dimm> dimms_;
   ndctl_ctx *ctx_ = nullptr;
@@ -72,6 +73,15 @@ class DimmNamespace final {
     return this->test_dir_;
   }
 
+  /*
+   * GetNumaNode -- returns NUMA node of the namespace reported by libndctl
+   * or, if it does not know, by sysfs attributes of the backing device.
+   * Returns -1 if it is unknown.
+   */
+  int GetNumaNode() const {
+    return this->numa_node_;
+  }
+
   Dimm &operator[](std::size_t idx) {
     return this->dimms_.at(idx);
   }
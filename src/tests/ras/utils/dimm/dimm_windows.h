@@ -58,6 +58,13 @@ class DimmNamespace final {
     return this->uid_;
   }
 
+  /*
+   * GetNumaNode -- returns NUMA node of the namespace, -1 if it is unknown.
+   */
+  int GetNumaNode() const {
+    return ApiC::GetNumaNode(mountpoint_);
+  }
+
   ~DimmNamespace(){};
 };
 
@@ -35,13 +35,13 @@
 #include "inject_manager.h"
 
 int InjectManager::ReadRecordedUSC(const std::string &usc_file_path) const {
-  std::string content;
-  if (ApiC::ReadFile(usc_file_path, content) != 0) {
+  FileView content;
+  if (ApiC::MapFile(usc_file_path, content) != 0) {
     return -1;
   }
 
   try {
-    return std::stoi(content);
+    return std::stoi(content.ToString());
   } catch (const std::invalid_argument &e) {
     std::cerr << e.what() << std::endl;
     return -1;
@@ -59,8 +59,8 @@ int InjectManager::RecordDimmUSC(const Dimm &dimm) const {
     return -1;
   }
 
-  if (ApiC::CreateFileT(test_dir_ + SEPARATOR + dimm.GetUid(),
-                        std::to_string(usc)) == -1) {
+  if (ApiC::CreatePmemFileT(test_dir_ + SEPARATOR + dimm.GetUid(),
+                            std::to_string(usc)) == -1) {
     return -1;
   }
   return 0;
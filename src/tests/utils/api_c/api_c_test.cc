@@ -0,0 +1,141 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "api_c/api_c.h"
+#include "file_test.h"
+
+/**
+ * API_C_CREATE_PMEM_FILE
+ * Writing file through memory mapping
+ * \test
+ *          \li \c Step1. Create file with given content / SUCCESS
+ *          \li \c Step2. Read the file and make sure content is the same
+ *          \li \c Step3. Create file from lines / SUCCESS
+ *          \li \c Step4. Make sure every line is terminated with newline
+ */
+TEST_F(FileTest, API_C_CREATE_PMEM_FILE) {
+  const std::string path = test_dir_ + "file";
+  const std::string content(3 * 4096 + 5, 'x');
+  std::string read;
+  /* Step 1 */
+  ASSERT_EQ(0, ApiC::CreatePmemFileT(path, content));
+  /* Step 2 */
+  ASSERT_EQ(0, ApiC::ReadFile(path, read));
+  EXPECT_EQ(content, read);
+  /* Step 3 */
+  const std::vector<std::string> lines{"first", "second"};
+  ASSERT_EQ(0, ApiC::CreatePmemFileT(path + "_lines", lines));
+  /* Step 4 */
+  ASSERT_EQ(0, ApiC::ReadFile(path + "_lines", read));
+  EXPECT_EQ("first\nsecond\n", read);
+}
+
+/**
+ * API_C_CREATE_PMEM_FILE_EMPTY
+ * Writing empty file, which cannot be memory mapped
+ * \test
+ *          \li \c Step1. Create file with empty content / SUCCESS
+ *          \li \c Step2. Make sure the file exists and is empty
+ */
+TEST_F(FileTest, API_C_CREATE_PMEM_FILE_EMPTY) {
+  const std::string path = test_dir_ + "file";
+  /* Step 1 */
+  ASSERT_EQ(0, ApiC::CreatePmemFileT(path, ""));
+  /* Step 2 */
+  EXPECT_TRUE(ApiC::RegularFileExists(path));
+  EXPECT_EQ(0, ApiC::GetFileSize(path));
+}
+
+/**
+ * API_C_MAP_FILE
+ * Reading file through read-only memory mapping
+ * \test
+ *          \li \c Step1. Create file with given content / SUCCESS
+ *          \li \c Step2. Map the file / SUCCESS
+ *          \li \c Step3. Make sure mapped content is the same
+ *          \li \c Step4. Move the mapping to another view and make sure the
+ *          source view is empty
+ */
+TEST_F(FileTest, API_C_MAP_FILE) {
+  const std::string path = test_dir_ + "file";
+  const std::string content = "1234\n";
+  FileView view;
+  /* Step 1 */
+  ASSERT_EQ(0, ApiC::CreateFileT(path, content));
+  /* Step 2 */
+  ASSERT_EQ(0, ApiC::MapFile(path, view));
+  /* Step 3 */
+  EXPECT_EQ(content.size(), view.GetSize());
+  EXPECT_EQ(content, view.ToString());
+  /* Step 4 */
+  FileView moved = std::move(view);
+  EXPECT_TRUE(view.IsEmpty());
+  EXPECT_EQ(content, moved.ToString());
+}
+
+/**
+ * API_C_MAP_FILE_EMPTY
+ * Mapping empty file
+ * \test
+ *          \li \c Step1. Create empty file / SUCCESS
+ *          \li \c Step2. Map the file / SUCCESS
+ *          \li \c Step3. Make sure the view is empty
+ */
+TEST_F(FileTest, API_C_MAP_FILE_EMPTY) {
+  const std::string path = test_dir_ + "file";
+  FileView view;
+  /* Step 1 */
+  ASSERT_EQ(0, ApiC::CreateFileT(path, ""));
+  /* Step 2 */
+  ASSERT_EQ(0, ApiC::MapFile(path, view));
+  /* Step 3 */
+  EXPECT_TRUE(view.IsEmpty());
+  EXPECT_EQ("", view.ToString());
+}
+
+/**
+ * API_C_READ_MISSING_FILE
+ * Reading and mapping file which does not exist
+ * \test
+ *          \li \c Step1. Read file which does not exist / FAIL: ret = -1
+ *          \li \c Step2. Map file which does not exist / FAIL: ret = -1
+ */
+TEST_F(FileTest, API_C_READ_MISSING_FILE) {
+  const std::string path = test_dir_ + "missing";
+  std::string content;
+  FileView view;
+  /* Step 1 */
+  EXPECT_EQ(-1, ApiC::ReadFile(path, content));
+  /* Step 2 */
+  EXPECT_EQ(-1, ApiC::MapFile(path, view));
+  EXPECT_TRUE(view.IsEmpty());
+}
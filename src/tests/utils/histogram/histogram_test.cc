@@ -0,0 +1,196 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <limits>
+#include <vector>
+#include "gtest/gtest.h"
+#include "histogram/histogram.h"
+
+/**
+ * HISTOGRAM_EMPTY
+ * Reading statistics of histogram without samples
+ * \test
+ *          \li \c Step1. Create histogram / SUCCESS
+ *          \li \c Step2. Make sure count, min, max, mean and percentiles are 0
+ */
+TEST(HistogramTest, HISTOGRAM_EMPTY) {
+  /* Step 1 */
+  Histogram histogram;
+  /* Step 2 */
+  EXPECT_EQ(0u, histogram.GetCount());
+  EXPECT_EQ(0u, histogram.GetMin());
+  EXPECT_EQ(0u, histogram.GetMax());
+  EXPECT_EQ(0, histogram.GetMean());
+  EXPECT_EQ(0u, histogram.GetPercentile(0));
+  EXPECT_EQ(0u, histogram.GetPercentile(100));
+}
+
+/**
+ * HISTOGRAM_BUCKETS
+ * Placing values in buckets
+ * \test
+ *          \li \c Step1. Record values below SUB_BUCKETS / SUCCESS
+ *          \li \c Step2. Make sure each of them has its own bucket
+ *          \li \c Step3. Record values of consecutive powers of two and their
+ *          neighbours, each in new histogram along with maximal value
+ *          \li \c Step4. Make sure the bucket value is not lower than recorded
+ *          value and relative error is below 2 / SUB_BUCKETS
+ */
+TEST(HistogramTest, HISTOGRAM_BUCKETS) {
+  Histogram small;
+  std::vector<uint64_t> values;
+  /* Step 1 */
+  for (uint64_t value = 0; value < Histogram::SUB_BUCKETS; ++value) {
+    small.Record(value);
+  }
+  /* Step 2 */
+  small.ForEachBucket([&](uint64_t value, uint64_t count) {
+    EXPECT_EQ(1u, count);
+    values.emplace_back(value);
+  });
+  ASSERT_EQ(Histogram::SUB_BUCKETS, values.size());
+  for (uint64_t value = 0; value < Histogram::SUB_BUCKETS; ++value) {
+    EXPECT_EQ(value, values[value]);
+  }
+  /* Step 3 */
+  for (unsigned bit = 7; bit < 64; ++bit) {
+    for (uint64_t value : {(1ULL << bit) - 1, 1ULL << bit, (1ULL << bit) + 1,
+                           (1ULL << bit) + (1ULL << (bit - 1))}) {
+      Histogram histogram;
+      histogram.Record(value);
+      /* otherwise bucket value is limited to the maximal recorded one */
+      histogram.Record(std::numeric_limits<uint64_t>::max());
+      uint64_t bucket = 0;
+      histogram.ForEachBucket([&](uint64_t highest, uint64_t) {
+        if (bucket == 0) {
+          bucket = highest;
+        }
+      });
+      /* Step 4 */
+      EXPECT_LE(value, bucket) << value;
+      /* compared in integers, doubles round large values */
+      EXPECT_LT(bucket - value, value / (Histogram::SUB_BUCKETS / 2)) << value;
+    }
+  }
+}
+
+/**
+ * HISTOGRAM_PERCENTILES
+ * Reading percentiles of recorded values
+ * \test
+ *          \li \c Step1. Record values from 1 to 100 / SUCCESS
+ *          \li \c Step2. Make sure percentile 0 is the minimal value, 100 the
+ *          maximal one and percentiles in between are exact
+ *          \li \c Step3. Make sure percentiles out of range are limited to 0
+ *          and 100
+ */
+TEST(HistogramTest, HISTOGRAM_PERCENTILES) {
+  Histogram histogram;
+  /* Step 1 */
+  for (uint64_t value = 100; value > 0; --value) {
+    histogram.Record(value);
+  }
+  /* Step 2 */
+  EXPECT_EQ(100u, histogram.GetCount());
+  EXPECT_EQ(1u, histogram.GetPercentile(0));
+  EXPECT_EQ(50u, histogram.GetPercentile(50));
+  EXPECT_EQ(99u, histogram.GetPercentile(99));
+  EXPECT_EQ(100u, histogram.GetPercentile(100));
+  EXPECT_DOUBLE_EQ(50.5, histogram.GetMean());
+  /* Step 3 */
+  EXPECT_EQ(1u, histogram.GetPercentile(-1));
+  EXPECT_EQ(100u, histogram.GetPercentile(101));
+}
+
+/**
+ * HISTOGRAM_MAX_VALUE
+ * Recording the largest value of uint64_t, which falls in the last bucket
+ * \test
+ *          \li \c Step1. Record 0 and maximal uint64_t value / SUCCESS
+ *          \li \c Step2. Make sure min, max and percentiles are exact
+ *          \li \c Step3. Make sure the last bucket holds the maximal value
+ */
+TEST(HistogramTest, HISTOGRAM_MAX_VALUE) {
+  const uint64_t max = std::numeric_limits<uint64_t>::max();
+  Histogram histogram;
+  uint64_t last = 0;
+  /* Step 1 */
+  histogram.Record(0);
+  histogram.Record(max);
+  /* Step 2 */
+  EXPECT_EQ(2u, histogram.GetCount());
+  EXPECT_EQ(0u, histogram.GetMin());
+  EXPECT_EQ(max, histogram.GetMax());
+  EXPECT_EQ(0u, histogram.GetPercentile(50));
+  EXPECT_EQ(max, histogram.GetPercentile(100));
+  /* Step 3 */
+  histogram.ForEachBucket([&](uint64_t value, uint64_t) { last = value; });
+  EXPECT_EQ(max, last);
+}
+
+/**
+ * HISTOGRAM_ADD
+ * Merging histograms recorded separately
+ * \test
+ *          \li \c Step1. Record odd values in one histogram and even values in
+ *          another one / SUCCESS
+ *          \li \c Step2. Add the second histogram and an empty one to the
+ *          first one / SUCCESS
+ *          \li \c Step3. Make sure statistics are equal to those of histogram
+ *          with all values recorded
+ *          \li \c Step4. Reset the merged histogram and make sure it is empty
+ */
+TEST(HistogramTest, HISTOGRAM_ADD) {
+  Histogram odd, even, empty, all;
+  /* Step 1 */
+  for (uint64_t value = 1; value <= 10000; ++value) {
+    (value % 2 ? odd : even).Record(value);
+    all.Record(value);
+  }
+  /* Step 2 */
+  odd.Add(even);
+  odd.Add(empty);
+  /* Step 3 */
+  EXPECT_EQ(all.GetCount(), odd.GetCount());
+  EXPECT_EQ(all.GetMin(), odd.GetMin());
+  EXPECT_EQ(all.GetMax(), odd.GetMax());
+  EXPECT_DOUBLE_EQ(all.GetMean(), odd.GetMean());
+  for (double percent : {0.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+    EXPECT_EQ(all.GetPercentile(percent), odd.GetPercentile(percent))
+        << percent;
+  }
+  /* Step 4 */
+  odd.Reset();
+  EXPECT_EQ(0u, odd.GetCount());
+  EXPECT_EQ(0u, odd.GetMax());
+  EXPECT_EQ(0u, odd.GetPercentile(100));
+}
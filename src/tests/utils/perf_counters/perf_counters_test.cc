@@ -0,0 +1,87 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iostream>
+#include <thread>
+#include "gtest/gtest.h"
+#include "perf_counters/perf_counters.h"
+
+namespace {
+/* iterations of counted loop, executing at least as many instructions */
+const unsigned long LOOP_ITERATIONS = 10000000;
+
+void Loop() {
+  volatile unsigned long counter = 0;
+  for (unsigned long i = 0; i < LOOP_ITERATIONS; ++i) {
+    counter = counter + 1;
+  }
+}
+}  // namespace
+
+/**
+ * PERF_COUNTERS_SCOPE_AFTER_THREAD
+ * Counting events of a region after region which started a thread
+ * \test
+ *          \li \c Step1. Count instructions of a thread started and joined in
+ *          the first scope / SUCCESS
+ *          \li \c Step2. Count instructions of the second scope, which runs no
+ *          work / SUCCESS
+ *          \li \c Step3. Make sure instructions of the thread are not counted
+ *          in the second scope
+ */
+TEST(PerfCountersTest, PERF_COUNTERS_SCOPE_AFTER_THREAD) {
+  PerfCounters counters;
+  double first = 0;
+  double second = 0;
+  if (!counters.IsAvailable()) {
+    std::cout << "Performance counters are not available ("
+              << counters.GetError() << "), test skipped" << std::endl;
+    return;
+  }
+
+  /* Step 1 */
+  {
+    PerfCounters::Scope counting(counters);
+    std::thread thread(Loop);
+    thread.join();
+  }
+  if (!counters.GetValue(PerfEvent::instructions, first)) {
+    std::cout << "Instructions are not counted, test skipped" << std::endl;
+    return;
+  }
+  ASSERT_LE(LOOP_ITERATIONS, first);
+  /* Step 2 */
+  { PerfCounters::Scope counting(counters); }
+  ASSERT_TRUE(counters.GetValue(PerfEvent::instructions, second));
+  /* Step 3 */
+  EXPECT_GT(LOOP_ITERATIONS / 10, second);
+}
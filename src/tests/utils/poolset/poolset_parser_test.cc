@@ -0,0 +1,147 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "api_c/api_c.h"
+#include "file_test.h"
+#include "poolset/poolset_parser.h"
+
+class PoolsetParserMalformedTest
+    : public ::testing::TestWithParam<std::string> {};
+
+/**
+ * POOLSET_PARSER_VALID
+ * Parsing pool set file with comments, options, directory part and remote
+ * replica
+ * \test
+ *          \li \c Step1. Write pool set file / SUCCESS
+ *          \li \c Step2. Parse the file / SUCCESS
+ *          \li \c Step3. Make sure name, options, replicas and parts are read
+ *          as written
+ */
+TEST_F(FileTest, POOLSET_PARSER_VALID) {
+  const std::string path = test_dir_ + "valid.set";
+  const std::vector<std::string> lines{"# pool set with every kind of line",
+                                       "PMEMPOOLSET",
+                                       "OPTION SINGLEHDR",
+                                       "  20M /mnt/pmem0/part0  # comment",
+                                       "",
+                                       "1G\t/mnt/pmem0/dir" + SEPARATOR,
+                                       "REPLICA",
+                                       "64M /mnt/pmem1/part0",
+                                       "REPLICA node0 remote.set"};
+  Poolset poolset;
+  /* Step 1 */
+  ASSERT_EQ(0, ApiC::CreatePmemFileT(path, lines));
+  /* Step 2 */
+  ASSERT_EQ(0, PoolsetParser().Parse(path, poolset));
+  /* Step 3 */
+  EXPECT_EQ("valid.set", poolset.GetName());
+  ASSERT_EQ(1u, poolset.GetOptions().size());
+  EXPECT_EQ("SINGLEHDR", poolset.GetOptions()[0]);
+  ASSERT_EQ(3u, poolset.GetReplicas().size());
+
+  const Replica &master = poolset.GetReplica(0);
+  ASSERT_EQ(2u, master.GetParts().size());
+  EXPECT_EQ("20M", master.GetPart(0).GetSize());
+  EXPECT_EQ(20u << 20, master.GetPart(0).GetByteSize());
+  EXPECT_EQ("/mnt/pmem0/part0", master.GetPart(0).GetPath());
+  EXPECT_FALSE(master.GetPart(0).IsDirectory());
+  EXPECT_TRUE(master.GetPart(1).IsDirectory());
+
+  ASSERT_EQ(1u, poolset.GetReplica(1).GetParts().size());
+  EXPECT_FALSE(poolset.GetReplica(1).IsRemote());
+
+  const Replica &remote = poolset.GetReplica(2);
+  EXPECT_TRUE(remote.IsRemote());
+  EXPECT_EQ("node0", remote.GetRemoteNode());
+  EXPECT_EQ("remote.set", remote.GetRemotePoolset());
+  EXPECT_TRUE(remote.GetParts().empty());
+}
+
+/**
+ * POOLSET_PARSER_MISSING_FILE
+ * Parsing pool set file which does not exist
+ * \test
+ *          \li \c Step1. Parse file which does not exist / FAIL: returns -1
+ */
+TEST_F(FileTest, POOLSET_PARSER_MISSING_FILE) {
+  Poolset poolset;
+  /* Step 1 */
+  EXPECT_EQ(-1, PoolsetParser().Parse(test_dir_ + "missing.set", poolset));
+}
+
+/**
+ * POOLSET_PARSER_MALFORMED
+ * Parsing pool set content with malformed line
+ * \test
+ *          \li \c Step1. Parse the content / FAIL: returns -1
+ */
+TEST_P(PoolsetParserMalformedTest, POOLSET_PARSER_MALFORMED) {
+  Poolset poolset;
+  /* Step 1 */
+  EXPECT_EQ(-1,
+            PoolsetParser().ParseContent(GetParam(), "malformed.set", poolset));
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Header, PoolsetParserMalformedTest,
+    ::testing::Values("", "# comment only\n", "20M /mnt/pmem0/part0\n",
+                      "PMEMPOOLSET extra\n20M /mnt/pmem0/part0\n",
+                      "pmempoolset\n20M /mnt/pmem0/part0\n"));
+
+INSTANTIATE_TEST_CASE_P(
+    Option, PoolsetParserMalformedTest,
+    ::testing::Values("PMEMPOOLSET\nOPTION\n20M /mnt/pmem0/part0\n",
+                      "PMEMPOOLSET\nOPTION UNKNOWN\n20M /mnt/pmem0/part0\n",
+                      "PMEMPOOLSET\nOPTION SINGLEHDR NOHDRS\n"
+                      "20M /mnt/pmem0/part0\n",
+                      "PMEMPOOLSET\n20M /mnt/pmem0/part0\nOPTION SINGLEHDR\n"));
+
+INSTANTIATE_TEST_CASE_P(
+    Part, PoolsetParserMalformedTest,
+    ::testing::Values("PMEMPOOLSET\n", "PMEMPOOLSET\n20M\n",
+                      "PMEMPOOLSET\n20X /mnt/pmem0/part0\n",
+                      "PMEMPOOLSET\n-20M /mnt/pmem0/part0\n",
+                      "PMEMPOOLSET\n/mnt/pmem0/part0 20M\n",
+                      "PMEMPOOLSET\n20M /mnt/pmem0/part0 extra\n"));
+
+INSTANTIATE_TEST_CASE_P(
+    Replica, PoolsetParserMalformedTest,
+    ::testing::Values("PMEMPOOLSET\nREPLICA\n20M /mnt/pmem1/part0\n",
+                      "PMEMPOOLSET\n20M /mnt/pmem0/part0\nREPLICA\n",
+                      "PMEMPOOLSET\n20M /mnt/pmem0/part0\nREPLICA\nREPLICA\n"
+                      "20M /mnt/pmem1/part0\n",
+                      "PMEMPOOLSET\n20M /mnt/pmem0/part0\nREPLICA node0\n",
+                      "PMEMPOOLSET\n20M /mnt/pmem0/part0\n"
+                      "REPLICA node0 remote.set extra\n",
+                      "PMEMPOOLSET\n20M /mnt/pmem0/part0\n"
+                      "REPLICA node0 remote.set\n20M /mnt/pmem1/part0\n"));
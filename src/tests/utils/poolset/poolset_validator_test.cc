@@ -0,0 +1,92 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "api_c/api_c.h"
+#include "file_test.h"
+#include "poolset/poolset_validator.h"
+
+/**
+ * POOLSET_VALIDATOR_FAILURES
+ * Validating pool set large enough to be split between threads, with parts
+ * which are missing, of wrong type, size or permissions
+ * \test
+ *          \li \c Step1. Create files of all parts of pool set / SUCCESS
+ *          \li \c Step2. Make sure pool set is valid
+ *          \li \c Step3. Remove one part, replace one with directory, resize
+ *          and change permissions of another ones / SUCCESS
+ *          \li \c Step4. Make sure all parts were checked and exactly the
+ *          damaged ones are reported, in order of parts
+ */
+TEST_F(FileTest, POOLSET_VALIDATOR_FAILURES) {
+  const unsigned parts = 4 * PoolsetValidator::PARTS_PER_THREAD;
+  const int mode = 0644;
+  std::vector<std::string> replica{"PMEMPOOLSET"};
+  for (unsigned i = 0; i < parts; ++i) {
+    replica.emplace_back("4K " + test_dir_ + "part" + std::to_string(i));
+  }
+  Poolset poolset(test_dir_, "validator.set", {replica});
+  const std::vector<Part> &all = poolset.GetReplica(0).GetParts();
+  const PoolsetValidator validator(4);
+  /* Step 1 */
+  for (const auto &part : all) {
+    ASSERT_EQ(0, ApiC::CreateFileT(part.GetPath(), std::string(4096, 'x')));
+    ASSERT_EQ(0, ApiC::SetFilePermission(part.GetPath(), mode));
+  }
+  /* Step 2 */
+  ValidationReport report = validator.Validate(poolset, mode);
+  EXPECT_TRUE(report.IsValid());
+  EXPECT_EQ(parts, report.GetCheckedCount());
+  /* Step 3 */
+  ASSERT_EQ(0, ApiC::RemoveFile(all[1].GetPath()));
+  ASSERT_EQ(0, ApiC::RemoveFile(all[70].GetPath()));
+  ASSERT_EQ(0, ApiC::CreateDirectoryT(all[70].GetPath()));
+  ASSERT_EQ(0, ApiC::CreateFileT(all[140].GetPath(), std::string(100, 'x')));
+  ASSERT_EQ(0, ApiC::SetFilePermission(all[parts - 1].GetPath(), 0600));
+  /* Step 4 */
+  report = validator.Validate(poolset, mode);
+  EXPECT_FALSE(report.IsValid());
+  EXPECT_EQ(parts, report.GetCheckedCount());
+  const std::vector<PartReport> &failures = report.GetFailures();
+  ASSERT_EQ(4u, failures.size());
+  EXPECT_EQ(&all[1], failures[0].part);
+  EXPECT_EQ(PartStatus::Missing, failures[0].status);
+  EXPECT_EQ(&all[70], failures[1].part);
+  EXPECT_EQ(PartStatus::WrongType, failures[1].status);
+  EXPECT_EQ(&all[140], failures[2].part);
+  EXPECT_EQ(PartStatus::SizeMismatch, failures[2].status);
+  EXPECT_EQ(100u, failures[2].actual_size);
+  EXPECT_EQ(&all[parts - 1], failures[3].part);
+  EXPECT_EQ(PartStatus::ModeMismatch, failures[3].status);
+  EXPECT_EQ(0600, failures[3].actual_mode);
+  /* directory has to be removed before files are removed with test dir */
+  EXPECT_EQ(0, ApiC::RemoveDirectoryT(all[70].GetPath()));
+}
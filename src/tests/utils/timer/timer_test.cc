@@ -0,0 +1,78 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <thread>
+#include "gtest/gtest.h"
+#include "timer/timer.h"
+
+/**
+ * TIMER_ELAPSED
+ * Measuring sleep of known length with calibrated timer
+ * \test
+ *          \li \c Step1. Calibrate the timer / SUCCESS, or monotonic clock is
+ *          used if invariant time stamp counter is not available
+ *          \li \c Step2. Sleep for 20 ms between reading ticks / SUCCESS
+ *          \li \c Step3. Make sure ticks do not decrease and measured time is
+ *          at least the sleep time, less calibration error
+ */
+TEST(TimerTest, TIMER_ELAPSED) {
+  /* Step 1 */
+  Timer::Calibrate();
+  /* Step 2 */
+  uint64_t start = Timer::ReadTicks();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  uint64_t end = Timer::ReadTicks();
+  uint64_t elapsed_ns = Timer::GetElapsedNanoseconds(start);
+  /* Step 3 */
+  ASSERT_LE(start, end);
+  EXPECT_LE(19000000, Timer::ToNanoseconds(end - start));
+  EXPECT_LE(19000000u, elapsed_ns);
+  EXPECT_GT(10000000000u, elapsed_ns);
+}
+
+/**
+ * TIMER_MONOTONIC_CLOCK
+ * Reading monotonic clock used when time stamp counter is not
+ * \test
+ *          \li \c Step1. Read clock twice with 20 ms sleep in between /
+ *          SUCCESS
+ *          \li \c Step2. Make sure the difference is at least the sleep time
+ */
+TEST(TimerTest, TIMER_MONOTONIC_CLOCK) {
+  /* Step 1 */
+  uint64_t start = Timer::ReadClockNanoseconds();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  uint64_t end = Timer::ReadClockNanoseconds();
+  /* Step 2 */
+  EXPECT_LE(start + 20000000, end);
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "heap_map.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+void AddRun(ZoneMap &zone, unsigned long long block_size,
+            unsigned long long used_blocks, unsigned long long total_blocks) {
+  auto fill = std::find_if(zone.classes.begin(), zone.classes.end(),
+                           [block_size](const RunClassFill &run_class) {
+                             return run_class.block_size == block_size;
+                           });
+
+  if (fill == zone.classes.end()) {
+    zone.classes.emplace_back();
+    fill = zone.classes.end() - 1;
+    fill->block_size = block_size;
+  }
+
+  ++fill->runs;
+  fill->used_blocks += used_blocks;
+  fill->total_blocks += total_blocks;
+}
+}  // namespace
+
+int HeapMap::Build(const PoolInfo &info) {
+  const StringView zone_title = "Zone ";
+  const StringView chunk_title = "Chunk ";
+
+  zones_.clear();
+
+  /* chunks belong to the zone printed last, whatever their indentation */
+  for (const auto &section : info.GetSections()) {
+    if (section.title.StartsWith(zone_title)) {
+      zones_.emplace_back();
+      PoolInfo::ToNumber(section.title.Substr(zone_title.GetSize()),
+                         zones_.back().index);
+      continue;
+    }
+
+    if (!section.title.StartsWith(chunk_title) || zones_.empty()) {
+      continue;
+    }
+
+    ZoneMap &zone = zones_.back();
+    StringView type = info.GetValue(section, "Type");
+    unsigned long long size_idx;
+    if (!info.GetNumber(section, "Size idx", size_idx) || size_idx == 0) {
+      size_idx = 1;
+    }
+
+    if (type == "free") {
+      zone.free_chunks += size_idx;
+      zone.largest_free = std::max(zone.largest_free, size_idx);
+    } else if (type == "used") {
+      zone.used_chunks += size_idx;
+    } else if (type == "run") {
+      zone.run_chunks += size_idx;
+
+      /* bitmap is printed as "<used blocks> / <all blocks>" */
+      unsigned long long block_size = 0, used_blocks = 0, total_blocks = 0;
+      StringView bitmap = info.GetValue(section, "Bitmap");
+      info.GetNumber(section, "Block size", block_size);
+      PoolInfo::ToNumber(bitmap, used_blocks);
+      size_t slash = bitmap.Find('/');
+      if (slash != StringView::npos) {
+        PoolInfo::ToNumber(bitmap.Substr(slash + 1).Trim(), total_blocks);
+      }
+      AddRun(zone, block_size, used_blocks, total_blocks);
+    }
+  }
+
+  if (zones_.empty()) {
+    std::cerr << "No heap zones found in pmempool info output" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+double HeapMap::GetFragmentationIndex() const {
+  unsigned long long free_chunks = 0, largest_free = 0;
+
+  for (const auto &zone : zones_) {
+    free_chunks += zone.free_chunks;
+    largest_free = std::max(largest_free, zone.largest_free);
+  }
+
+  return free_chunks == 0
+             ? 0
+             : 1 - static_cast<double>(largest_free) / free_chunks;
+}
+
+double HeapMap::GetRunFill() const {
+  unsigned long long used_blocks = 0, total_blocks = 0;
+
+  for (const auto &zone : zones_) {
+    for (const auto &fill : zone.classes) {
+      used_blocks += fill.used_blocks;
+      total_blocks += fill.total_blocks;
+    }
+  }
+
+  return total_blocks == 0
+             ? 0
+             : static_cast<double>(used_blocks) / total_blocks;
+}
+
+void HeapMap::WriteJson(std::ostream &stream,
+                        unsigned long long operations) const {
+  stream << "{\"operations\":" << operations
+         << ",\"fragmentation_index\":" << GetFragmentationIndex()
+         << ",\"run_fill\":" << GetRunFill() << ",\"zones\":[";
+
+  for (size_t i = 0; i < zones_.size(); ++i) {
+    const ZoneMap &zone = zones_[i];
+    stream << (i == 0 ? "" : ",") << "{\"index\":" << zone.index
+           << ",\"free_chunks\":" << zone.free_chunks
+           << ",\"used_chunks\":" << zone.used_chunks
+           << ",\"run_chunks\":" << zone.run_chunks
+           << ",\"largest_free\":" << zone.largest_free << ",\"classes\":[";
+
+    for (size_t j = 0; j < zone.classes.size(); ++j) {
+      const RunClassFill &fill = zone.classes[j];
+      stream << (j == 0 ? "" : ",") << "{\"block_size\":" << fill.block_size
+             << ",\"runs\":" << fill.runs
+             << ",\"used_blocks\":" << fill.used_blocks
+             << ",\"total_blocks\":" << fill.total_blocks << "}";
+    }
+    stream << "]}";
+  }
+
+  stream << "]}" << std::endl;
+}
+
+void HeapMap::WriteCsv(std::ostream &stream, unsigned long long operations,
+                       bool header) const {
+  if (header) {
+    stream << "operations,zone,free_chunks,used_chunks,run_chunks,"
+              "largest_free,block_size,runs,used_blocks,total_blocks"
+           << std::endl;
+  }
+
+  for (const auto &zone : zones_) {
+    std::string prefix = std::to_string(operations) + "," +
+                         std::to_string(zone.index) + "," +
+                         std::to_string(zone.free_chunks) + "," +
+                         std::to_string(zone.used_chunks) + "," +
+                         std::to_string(zone.run_chunks) + "," +
+                         std::to_string(zone.largest_free) + ",";
+
+    if (zone.classes.empty()) {
+      stream << prefix << ",,," << std::endl;
+    }
+    for (const auto &fill : zone.classes) {
+      stream << prefix << fill.block_size << "," << fill.runs << ","
+             << fill.used_blocks << "," << fill.total_blocks << std::endl;
+    }
+  }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_TOOLS_HEAP_MAP_HEAP_MAP_H_
+#define PMDK_TESTS_SRC_TOOLS_HEAP_MAP_HEAP_MAP_H_
+
+#include <ostream>
+#include <vector>
+#include "pool_info/pool_info.h"
+
+/*
+ * RunClassFill -- occupancy of runs of single block size.
+ */
+struct RunClassFill {
+  unsigned long long block_size = 0;
+  unsigned long long runs = 0;
+  unsigned long long used_blocks = 0;
+  unsigned long long total_blocks = 0;
+};
+
+/*
+ * ZoneMap -- occupancy of chunks of single zone, counted in chunks.
+ */
+struct ZoneMap {
+  unsigned long long index = 0;
+  unsigned long long free_chunks = 0;
+  unsigned long long used_chunks = 0;
+  unsigned long long run_chunks = 0;
+  unsigned long long largest_free = 0;
+  std::vector<RunClassFill> classes;
+};
+
+/*
+ * HeapMap -- fragmentation map of pmemobj heap built from pmempool info
+ * --heap --zones --chunks output.
+ */
+class HeapMap final {
+ private:
+  std::vector<ZoneMap> zones_;
+
+ public:
+  const std::vector<ZoneMap> &GetZones() const {
+    return zones_;
+  }
+
+  /*
+   * Build -- collects zones and chunks from parsed pmempool info output.
+   * Returns 0 on success, prints error message and returns -1 if output
+   * holds no zones.
+   */
+  int Build(const PoolInfo &info);
+
+  /*
+   * GetFragmentationIndex -- returns 1 - largest free extent / free chunks,
+   * i.e. 0 if all free space is contiguous and approaching 1 as it is split
+   * into single chunks. Returns 0 if there is no free chunk.
+   */
+  double GetFragmentationIndex() const;
+
+  /*
+   * GetRunFill -- returns ratio of used to all blocks of runs in the heap.
+   * Returns 0 if there is no run.
+   */
+  double GetRunFill() const;
+
+  /*
+   * WriteJson -- writes map as single line JSON object, tagged with number of
+   * operations of aging workload done before.
+   */
+  void WriteJson(std::ostream &stream, unsigned long long operations) const;
+
+  /*
+   * WriteCsv -- writes one line per zone and run class, tagged with number of
+   * operations of aging workload done before.
+   */
+  void WriteCsv(std::ostream &stream, unsigned long long operations,
+                bool header) const;
+};
+
+#endif  // !PMDK_TESTS_SRC_TOOLS_HEAP_MAP_HEAP_MAP_H_
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libpmemobj.h>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "api_c/api_c.h"
+#include "heap_map.h"
+#include "shell/i_shell.h"
+
+namespace {
+const size_t MIN_OBJECT_SIZE = 16;
+const size_t MAX_OBJECT_SIZE = 256 * 1024;
+
+void PrintUsage(const char *name) {
+  std::cerr << "Usage: " << name
+            << " [--format json|csv] [--age OPERATIONS] [--rounds N]"
+               " [--seed SEED] [--output FILE] POOL"
+            << std::endl
+            << "Exports fragmentation map of pmemobj pool heap. With --age,"
+               " runs N rounds of random allocations and frees and exports"
+               " the map after each of them."
+            << std::endl;
+}
+
+int ParseNumber(const char *arg, unsigned long long &number) {
+  char *end;
+  number = std::strtoull(arg, &end, 10);
+
+  if (*arg == '\0' || *end != '\0') {
+    std::cerr << "Invalid number: " << arg << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+/*
+ * CollectHeapMap -- dumps zones and chunks of the pool with pmempool info to
+ * a file next to the pool and builds heap map from it. Returns 0 on success,
+ * prints error message and returns -1 otherwise.
+ */
+int CollectHeapMap(const std::string &path, HeapMap &heap_map) {
+  std::string dump_path = path + ".chunks";
+  IShell shell;
+  Output<> output = shell.ExecuteCommand(
+      "pmempool info --heap --zones --chunks " + path + " > " + dump_path);
+
+  if (output.GetExitCode() != 0) {
+    std::cerr << "pmempool info failed: " << output.GetContent() << std::endl;
+    ApiC::RemoveFile(dump_path);
+    return -1;
+  }
+
+  int ret;
+  {
+    PoolInfo info;
+    ret = info.ParseFile(dump_path) == 0 ? heap_map.Build(info) : -1;
+  }
+
+  ApiC::RemoveFile(dump_path);
+  return ret;
+}
+
+/*
+ * AgePool -- runs given number of random allocations and frees of objects of
+ * log-uniformly distributed sizes. Allocated objects are kept in objects
+ * between calls. Returns 0 on success, prints error message and returns -1
+ * otherwise.
+ */
+int AgePool(const std::string &path, unsigned long long operations,
+            std::mt19937_64 &generator, std::vector<PMEMoid> &objects) {
+  PMEMobjpool *pop = pmemobj_open(path.c_str(), nullptr);
+  if (pop == nullptr) {
+    std::cerr << pmemobj_errormsg() << std::endl;
+    return -1;
+  }
+
+  std::uniform_real_distribution<double> size_exponent(
+      std::log2(MIN_OBJECT_SIZE), std::log2(MAX_OBJECT_SIZE));
+  std::bernoulli_distribution allocate(0.6);
+
+  for (unsigned long long i = 0; i < operations; ++i) {
+    if (objects.empty() || allocate(generator)) {
+      PMEMoid oid;
+      size_t size = static_cast<size_t>(std::exp2(size_exponent(generator)));
+      if (pmemobj_alloc(pop, &oid, size, 0, nullptr, nullptr) == 0) {
+        objects.push_back(oid);
+        continue;
+      }
+      if (errno != ENOMEM || objects.empty()) {
+        std::cerr << pmemobj_errormsg() << std::endl;
+        pmemobj_close(pop);
+        return -1;
+      }
+    }
+
+    /* free random object, also when the heap is full */
+    size_t victim =
+        std::uniform_int_distribution<size_t>(0, objects.size() - 1)(generator);
+    pmemobj_free(&objects[victim]);
+    objects[victim] = objects.back();
+    objects.pop_back();
+  }
+
+  pmemobj_close(pop);
+  return 0;
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::string format = "json", output_path, path;
+  unsigned long long operations = 0, rounds = 1, seed = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    int ret = 0;
+
+    if (arg == "--format" && has_value) {
+      format = argv[++i];
+    } else if (arg == "--age" && has_value) {
+      ret = ParseNumber(argv[++i], operations);
+    } else if (arg == "--rounds" && has_value) {
+      ret = ParseNumber(argv[++i], rounds);
+    } else if (arg == "--seed" && has_value) {
+      ret = ParseNumber(argv[++i], seed);
+    } else if (arg == "--output" && has_value) {
+      output_path = argv[++i];
+    } else if (arg.compare(0, 2, "--") != 0 && path.empty()) {
+      path = arg;
+    } else {
+      ret = -1;
+    }
+
+    if (ret != 0) {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (path.empty() || (format != "json" && format != "csv")) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  std::ofstream file;
+  if (!output_path.empty()) {
+    file.open(output_path);
+    if (!file) {
+      std::cerr << "Cannot open " << output_path << std::endl;
+      return 1;
+    }
+  }
+  std::ostream &stream = output_path.empty() ? std::cout : file;
+
+  std::mt19937_64 generator(seed);
+  std::vector<PMEMoid> objects;
+  HeapMap heap_map;
+
+  for (unsigned long long round = 0; round <= rounds; ++round) {
+    /* without aging only the current state is exported */
+    if (round > 0) {
+      if (operations == 0) {
+        break;
+      }
+      if (AgePool(path, operations, generator, objects) != 0) {
+        return 1;
+      }
+    }
+
+    if (CollectHeapMap(path, heap_map) != 0) {
+      return 1;
+    }
+
+    if (format == "json") {
+      heap_map.WriteJson(stream, round * operations);
+    } else {
+      heap_map.WriteCsv(stream, round * operations, round == 0);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "recovery/recovery_orchestrator.h"
+
+namespace {
+void PrintUsage(const char *name) {
+  std::cerr << "Usage: " << name
+            << " [--check | --repair | --sync] [--jobs N] [--per-device N]"
+               " [--list FILE] [POOL...]"
+            << std::endl
+            << "Runs given action (--repair by default) on pools and pool"
+               " sets, queued by device they are placed on."
+            << std::endl;
+}
+
+/*
+ * ReadList -- appends non-empty lines of file in given path to paths. Returns
+ * 0 on success, prints error message and returns -1 otherwise.
+ */
+int ReadList(const std::string &path, std::vector<std::string> &paths) {
+  std::ifstream list(path);
+  if (!list) {
+    std::cerr << "Cannot open list " << path << std::endl;
+    return -1;
+  }
+
+  std::string line;
+  while (std::getline(list, line)) {
+    if (!line.empty()) {
+      paths.emplace_back(line);
+    }
+  }
+
+  return 0;
+}
+
+int ParseCount(const char *arg, unsigned &count) {
+  char *end;
+  unsigned long value = std::strtoul(arg, &end, 10);
+
+  if (*arg == '\0' || *end != '\0' || value == 0) {
+    std::cerr << "Invalid number: " << arg << std::endl;
+    return -1;
+  }
+
+  count = static_cast<unsigned>(value);
+  return 0;
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  RecoveryAction action = RecoveryAction::Repair;
+  unsigned jobs = 0, per_device = 1;
+  std::vector<std::string> paths;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+
+    if (arg == "--check") {
+      action = RecoveryAction::Check;
+    } else if (arg == "--repair") {
+      action = RecoveryAction::Repair;
+    } else if (arg == "--sync") {
+      action = RecoveryAction::Sync;
+    } else if (arg == "--jobs" && has_value) {
+      if (ParseCount(argv[++i], jobs) != 0) {
+        return 1;
+      }
+    } else if (arg == "--per-device" && has_value) {
+      if (ParseCount(argv[++i], per_device) != 0) {
+        return 1;
+      }
+    } else if (arg == "--list" && has_value) {
+      if (ReadList(argv[++i], paths) != 0) {
+        return 1;
+      }
+    } else if (arg.compare(0, 2, "--") == 0) {
+      PrintUsage(argv[0]);
+      return 1;
+    } else {
+      paths.emplace_back(arg);
+    }
+  }
+
+  if (paths.empty()) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  RecoveryOrchestrator orchestrator(jobs, per_device);
+  size_t width = std::to_string(paths.size()).size();
+  orchestrator.SetProgressCallback(
+      [width](const RecoveryResult &result, size_t completed, size_t total) {
+        std::cout << "[" << std::setw(width) << completed << "/" << total
+                  << "] " << (result.success ? "OK    " : "FAILED") << " "
+                  << std::fixed << std::setprecision(3) << result.seconds
+                  << " s " << result.path;
+        if (!result.message.empty()) {
+          std::cout << ": " << result.message;
+        }
+        std::cout << std::endl;
+      });
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<RecoveryResult> results;
+  int ret = orchestrator.Run(paths, action, results);
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  size_t succeeded = 0;
+  for (const auto &result : results) {
+    succeeded += result.success ? 1 : 0;
+  }
+  std::cout << succeeded << " of " << results.size() << " pools recovered in "
+            << std::fixed << std::setprecision(3) << seconds << " s"
+            << std::endl;
+
+  return ret == 0 ? 0 : 1;
+}
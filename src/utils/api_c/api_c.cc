@@ -40,8 +40,9 @@
 
 #include "api_c.h"
 
+#include <libpmem.h>
+#include <cstring>
 #include <fstream>
-#include <sstream>
 
 int ApiC::CreateFileT(const std::string &path, const std::string &content) {
   std::ofstream file{path, std::ios::binary};
@@ -67,17 +68,72 @@ int ApiC::CreateFileT(const std::string &path,
   return CreateFileT(path, std::move(c));
 }
 
+int ApiC::CreatePmemFileT(const std::string &path,
+                          const std::string &content) {
+  /* pmem_map_file cannot create zero-length mapping */
+  if (content.empty()) {
+    return CreateFileT(path, content);
+  }
+
+  size_t mapped_len;
+  int is_pmem;
+  void *addr = pmem_map_file(path.c_str(), content.size(), PMEM_FILE_CREATE,
+                             0666, &mapped_len, &is_pmem);
+
+  if (addr == nullptr) {
+    std::cerr << "File mapping failed: " << pmem_errormsg() << std::endl;
+    return -1;
+  }
+
+  int ret = 0;
+  if (is_pmem) {
+    pmem_memcpy_persist(addr, content.data(), content.size());
+  } else {
+    memcpy(addr, content.data(), content.size());
+    if (pmem_msync(addr, content.size()) != 0) {
+      std::cerr << "msync failed: " << pmem_errormsg() << std::endl;
+      ret = -1;
+    }
+  }
+
+  if (pmem_unmap(addr, mapped_len) != 0) {
+    std::cerr << "File unmapping failed: " << pmem_errormsg() << std::endl;
+    ret = -1;
+  }
+
+  return ret;
+}
+
+int ApiC::CreatePmemFileT(const std::string &path,
+                          const std::vector<std::string> &content) {
+  std::string c;
+
+  for (const auto &line : content) {
+    c += line + "\n";
+  }
+
+  return CreatePmemFileT(path, c);
+}
+
 int ApiC::ReadFile(const std::string &path, std::string &content) {
-  std::ifstream file{path};
+  std::ifstream file{path, std::ios::ate};
 
   if (!file.good()) {
     std::cerr << "File opening failed" << std::endl;
     return -1;
   }
 
-  std::stringstream buffer;
-  buffer << file.rdbuf();
-  content = buffer.str();
+  std::streampos size = file.tellg();
+  if (size == std::streampos(-1)) {
+    std::cerr << "Unable to get file size" << std::endl;
+    return -1;
+  }
+
+  /* read directly into the output string to avoid intermediate buffers */
+  content.resize(static_cast<size_t>(size));
+  file.seekg(0);
+  file.read(&content[0], content.size());
+  content.resize(static_cast<size_t>(file.gcount()));
 
   return 0;
 }
@@ -38,8 +38,20 @@
 #include <string>
 #include <vector>
 #include "constants.h"
+#include "file_view.h"
 #include "non_copyable/non_copyable.h"
 
+/*
+ * FileStat -- status of file system entry as returned by ApiC::GetFileStat.
+ */
+struct FileStat {
+  bool is_regular = false;
+  bool is_directory = false;
+  unsigned long long size = 0;
+  unsigned short mode = 0;
+  unsigned long long device = 0;
+};
+
 class ApiC final : NonCopyable {
  public:
   /*
@@ -61,6 +73,23 @@ class ApiC final : NonCopyable {
   static int CreateFileT(const std::string &path,
                          const std::vector<std::string> &content);
 
+  /*
+   * CreatePmemFileT -- creates file in given path and writes content through
+   * memory mapping. Content is stored with pmem_memcpy_persist if the mapped
+   * file resides on persistent memory and flushed with msync otherwise. Returns
+   * 0 on success, prints error message and returns -1 otherwise.
+   */
+  static int CreatePmemFileT(const std::string &path,
+                             const std::string &content);
+
+  /*
+   * CreatePmemFileT -- creates file in given path and writes content through
+   * memory mapping. Returns 0 on success, prints error message and returns -1
+   * otherwise.
+   */
+  static int CreatePmemFileT(const std::string &path,
+                             const std::vector<std::string> &content);
+
   /*
    * AllocateFileSpace -- allocates disk space in specified path. Size of
    * allocation is equal to given length(specified in bytes). Returns 0 on
@@ -74,6 +103,22 @@ class ApiC final : NonCopyable {
    */
   static int ReadFile(const std::string &path, std::string &content);
 
+  /*
+   * MapFile -- maps given file read-only and assigns the mapping to view. Empty
+   * file results in empty view. Returns 0 on success, prints error message and
+   * returns -1 otherwise.
+   */
+  static int MapFile(const std::string &path, FileView &view);
+
+  /*
+   * CloneFile -- creates file in dst path with the same content and mode as
+   * file in src path. Shares data extents with the source file if underlying
+   * file system supports reflinks, falls back to in-kernel copy and plain
+   * copy otherwise. Returns 0 on success, prints error message and returns -1
+   * otherwise.
+   */
+  static int CloneFile(const std::string &src, const std::string &dst);
+
   /*
    * RegularFileExists -- checks that file in given path is regular. Returns
    * true on success, prints error message (if errno is different than ENOENT)
@@ -81,6 +126,14 @@ class ApiC final : NonCopyable {
    */
   static bool RegularFileExists(const std::string &path);
 
+  /*
+   * GetFileStat -- retrieves type, size, permission bits and device of entry
+   * in given path with a single system call. Does not print error message, so
+   * that callers can handle missing files. Returns 0 on success, -1 otherwise
+   * and leaves errno set.
+   */
+  static int GetFileStat(const std::string &path, FileStat &file_stat);
+
   /*
    * GetFileSize -- returns file size specified in bytes on success, prints
    * error message and
@@ -132,6 +185,14 @@ class ApiC final : NonCopyable {
    */
   static int CleanDirectory(const std::string &path);
 
+  /*
+   * ListDirectory -- assigns names of entries in given directory, excluding
+   * '.' and '..', to entries. Returns 0 on success, prints error message and
+   * returns -1 otherwise.
+   */
+  static int ListDirectory(const std::string &path,
+                           std::vector<std::string> &entries);
+
   /*
    * RemoveDirectoryT -- removes directory under given 'path'. Returns 0 on
    * success, prints error message and returns -1 otherwise.
@@ -144,6 +205,20 @@ class ApiC final : NonCopyable {
    */
   static long long GetFreeSpaceT(const std::string &path);
 
+  /*
+   * IsMemoryFileSystem -- checks that given path is placed on file system
+   * backed by RAM (tmpfs, ramfs or RAM disk). Returns false if it cannot be
+   * determined.
+   */
+  static bool IsMemoryFileSystem(const std::string &path);
+
+  /*
+   * GetAvailableMemory -- returns amount of physical memory in bytes
+   * available for new allocations without swapping, prints error message and
+   * returns -1 otherwise.
+   */
+  static long long GetAvailableMemory();
+
   /* SetEnv -- adds tne environment variable name to the environment
    * with the value value. Returns 0 on success, -1 otherwise. */
   static int SetEnv(const std::string &name, const std::string &value);
@@ -152,6 +227,45 @@ class ApiC final : NonCopyable {
    * Returns 0 on success, -1 otherwise. */
   static int UnsetEnv(const std::string &name);
 
+  /*
+   * GetProcessCpuTime -- returns CPU time in seconds (user and system) used
+   * by the calling process and, on Linux, its terminated and waited for
+   * children (e.g. commands run by tests).
+   */
+  static double GetProcessCpuTime();
+
+  /* GetProcessIdT -- returns identifier of the calling process. */
+  static unsigned long GetProcessIdT();
+
+  /*
+   * GetNumaNode -- returns NUMA node of device backing given path (device
+   * itself for block and character device files), as reported by its sysfs
+   * numa_node attribute or, for partitions, by that of the parent device.
+   * Returns -1 if it is unknown, e.g. on machines without NUMA.
+   */
+  static int GetNumaNode(const std::string &path);
+
+  /*
+   * GetOnlineNumaNodes -- retrieves identifiers of online NUMA nodes. Machine
+   * without NUMA has single node 0. Returns 0 on success, prints error message
+   * and returns -1 otherwise.
+   */
+  static int GetOnlineNumaNodes(std::vector<unsigned> &nodes);
+
+  /*
+   * GetNumaNodeCpus -- retrieves CPUs of given NUMA node, which may be none
+   * for memory-only nodes. Returns 0 on success, prints error message and
+   * returns -1 otherwise.
+   */
+  static int GetNumaNodeCpus(unsigned node, std::vector<unsigned> &cpus);
+
+  /*
+   * BindThreadToNumaNode -- restricts the calling thread to CPUs of given
+   * NUMA node. Returns 0 on success, prints error message and returns -1
+   * otherwise.
+   */
+  static int BindThreadToNumaNode(unsigned node);
+
 #ifdef _WIN32
   /*
    * CreateFileT -- creates file in given path and writes content. Returns 0 on
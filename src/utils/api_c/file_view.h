@@ -0,0 +1,102 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_API_C_FILE_VIEW_H_
+#define PMDK_TESTS_SRC_UTILS_API_C_FILE_VIEW_H_
+
+#include <cstddef>
+#include <string>
+#include "non_copyable/non_copyable.h"
+
+/*
+ * FileView -- read-only memory mapping of a whole file. The mapping is released
+ * when the object is destroyed or another mapping is assigned to it.
+ */
+class FileView final : NonCopyable {
+ private:
+  void *addr_ = nullptr;
+  size_t size_ = 0;
+
+ public:
+  FileView() = default;
+  FileView(FileView &&other) : addr_(other.addr_), size_(other.size_) {
+    other.addr_ = nullptr;
+    other.size_ = 0;
+  }
+  FileView &operator=(FileView &&other) {
+    if (this != &other) {
+      Unmap();
+      addr_ = other.addr_;
+      size_ = other.size_;
+      other.addr_ = nullptr;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  const char *GetData() const {
+    return static_cast<const char *>(addr_);
+  }
+  size_t GetSize() const {
+    return size_;
+  }
+  bool IsEmpty() const {
+    return size_ == 0;
+  }
+  /*
+   * ToString -- returns copy of the mapped content.
+   */
+  std::string ToString() const {
+    return size_ == 0 ? std::string{} : std::string{GetData(), size_};
+  }
+
+  /*
+   * Reset -- releases current mapping and takes ownership of the mapping
+   * described by addr and size.
+   */
+  void Reset(void *addr, size_t size) {
+    Unmap();
+    addr_ = addr;
+    size_ = size;
+  }
+
+  /*
+   * Unmap -- releases the mapping. Implemented per platform.
+   */
+  void Unmap();
+
+  ~FileView() {
+    Unmap();
+  }
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_API_C_FILE_VIEW_H_
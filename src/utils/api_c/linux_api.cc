@@ -32,15 +32,108 @@
 
 #ifdef __linux__
 
+#include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <fts.h>
+#include <sched.h>
 #include <libgen.h>
+#include <linux/fs.h>
+#include <linux/magic.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/statfs.h>
 #include <sys/statvfs.h>
+#include <sys/syscall.h>
+#include <sys/sysinfo.h>
+#include <sys/sysmacros.h>
 #include <unistd.h>
 #include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
 #include "api_c.h"
 
+namespace {
+/*
+ * ParseCpuList -- parses list in sysfs cpulist format (e.g. "0-3,8,10-11")
+ * into ids. Returns 0 on success, -1 otherwise.
+ */
+int ParseCpuList(const std::string &list, std::vector<unsigned> &ids) {
+  std::istringstream stream(list);
+  std::string range;
+
+  while (std::getline(stream, range, ',')) {
+    unsigned first, last;
+    char dash;
+    std::istringstream range_stream(range);
+
+    if (!(range_stream >> first)) {
+      return -1;
+    }
+    last = first;
+    if (range_stream >> dash && (dash != '-' || !(range_stream >> last))) {
+      return -1;
+    }
+    for (unsigned id = first; id <= last; ++id) {
+      ids.emplace_back(id);
+    }
+  }
+
+  return 0;
+}
+
+/*
+ * CopyFileRange -- copies length bytes between given descriptors in kernel.
+ * Returns 0 on success, -1 otherwise and leaves errno set.
+ */
+int CopyFileRange(int fd_in, int fd_out, size_t length) {
+#ifdef __NR_copy_file_range
+  while (length > 0) {
+    ssize_t ret = syscall(__NR_copy_file_range, fd_in, nullptr, fd_out,
+                          nullptr, length, 0);
+    if (ret <= 0) {
+      if (ret == 0) {
+        errno = EIO;
+      }
+      return -1;
+    }
+    length -= static_cast<size_t>(ret);
+  }
+  return 0;
+#else
+  (void)fd_in;
+  (void)fd_out;
+  (void)length;
+  errno = ENOSYS;
+  return -1;
+#endif  // __NR_copy_file_range
+}
+
+/*
+ * CopyFileContent -- copies file content between given descriptors through
+ * user space buffer. Returns 0 on success, -1 otherwise.
+ */
+int CopyFileContent(int fd_in, int fd_out) {
+  std::vector<char> buffer(MEBIBYTE);
+  ssize_t count;
+
+  while ((count = read(fd_in, buffer.data(), buffer.size())) > 0) {
+    ssize_t written = 0;
+    while (written < count) {
+      ssize_t ret = write(fd_out, buffer.data() + written, count - written);
+      if (ret < 0) {
+        return -1;
+      }
+      written += ret;
+    }
+  }
+
+  return count < 0 ? -1 : 0;
+}
+}  // namespace
+
 int ApiC::AllocateFileSpace(const std::string &path, size_t length) {
   if (static_cast<off_t>(length) < 0) {
     std::cerr << "length should be >= 0" << std::endl;
@@ -66,6 +159,166 @@ int ApiC::AllocateFileSpace(const std::string &path, size_t length) {
   return ret;
 }
 
+int ApiC::CloneFile(const std::string &src, const std::string &dst) {
+  int fd_in = open(src.c_str(), O_RDONLY);
+
+  if (fd_in == -1) {
+    std::cerr << "Unable to open file: " << strerror(errno) << std::endl;
+    return -1;
+  }
+
+  struct stat64 file_stat;
+  if (fstat64(fd_in, &file_stat) != 0) {
+    std::cerr << "Unable to get file stats: " << strerror(errno) << std::endl;
+    close(fd_in);
+    return -1;
+  }
+
+  int fd_out = open(dst.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                    file_stat.st_mode & PERMISSION_MASK);
+
+  if (fd_out == -1) {
+    std::cerr << "Unable to create file: " << strerror(errno) << std::endl;
+    close(fd_in);
+    return -1;
+  }
+
+  int ret = -1;
+#ifdef FICLONE
+  ret = ioctl(fd_out, FICLONE, fd_in);
+#endif  // FICLONE
+
+  if (ret != 0) {
+    ret = CopyFileRange(fd_in, fd_out, static_cast<size_t>(file_stat.st_size));
+  }
+
+  if (ret != 0) {
+    /* copy_file_range may have stopped halfway */
+    if (ftruncate(fd_out, 0) != 0 || lseek(fd_in, 0, SEEK_SET) != 0 ||
+        lseek(fd_out, 0, SEEK_SET) != 0) {
+      ret = -1;
+    } else {
+      ret = CopyFileContent(fd_in, fd_out);
+    }
+  }
+
+  /* mode passed to open is subject to umask */
+  if (ret == 0 && fchmod(fd_out, file_stat.st_mode & PERMISSION_MASK) != 0) {
+    ret = -1;
+  }
+
+  if (ret != 0) {
+    std::cerr << "Unable to clone file " << src << ": " << strerror(errno)
+              << std::endl;
+  }
+
+  close(fd_in);
+  close(fd_out);
+
+  if (ret != 0) {
+    RemoveFile(dst);
+  }
+
+  return ret;
+}
+
+int ApiC::GetFileStat(const std::string &path, FileStat &file_stat) {
+#ifdef STATX_BASIC_STATS
+  struct statx stx;
+
+  if (statx(AT_FDCWD, path.c_str(), 0, STATX_TYPE | STATX_MODE | STATX_SIZE,
+            &stx) != 0) {
+    return -1;
+  }
+
+  file_stat.is_regular = S_ISREG(stx.stx_mode);
+  file_stat.is_directory = S_ISDIR(stx.stx_mode);
+  file_stat.size = stx.stx_size;
+  file_stat.mode = stx.stx_mode & PERMISSION_MASK;
+  file_stat.device = makedev(stx.stx_dev_major, stx.stx_dev_minor);
+#else
+  struct stat64 st;
+
+  if (stat64(path.c_str(), &st) != 0) {
+    return -1;
+  }
+
+  file_stat.is_regular = S_ISREG(st.st_mode);
+  file_stat.is_directory = S_ISDIR(st.st_mode);
+  file_stat.size = st.st_size;
+  file_stat.mode = st.st_mode & PERMISSION_MASK;
+  file_stat.device = st.st_dev;
+#endif  // STATX_BASIC_STATS
+
+  return 0;
+}
+
+int ApiC::ListDirectory(const std::string &path,
+                        std::vector<std::string> &entries) {
+  DIR *dir = opendir(path.c_str());
+
+  if (dir == nullptr) {
+    std::cerr << "Unable to open directory: " << strerror(errno) << std::endl;
+    return -1;
+  }
+
+  entries.clear();
+  struct dirent *entry;
+
+  while ((entry = readdir(dir)) != nullptr) {
+    if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) {
+      entries.emplace_back(entry->d_name);
+    }
+  }
+
+  closedir(dir);
+  return 0;
+}
+
+int ApiC::MapFile(const std::string &path, FileView &view) {
+  int fd = open(path.c_str(), O_RDONLY);
+
+  if (fd == -1) {
+    std::cerr << "Unable to open file: " << strerror(errno) << std::endl;
+    return -1;
+  }
+
+  struct stat64 file_stat;
+  if (fstat64(fd, &file_stat) != 0) {
+    std::cerr << "Unable to get file size: " << strerror(errno) << std::endl;
+    close(fd);
+    return -1;
+  }
+
+  size_t size = static_cast<size_t>(file_stat.st_size);
+  if (size == 0) {
+    view.Reset(nullptr, 0);
+    close(fd);
+    return 0;
+  }
+
+  void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (addr == MAP_FAILED) {
+    std::cerr << "Unable to map file: " << strerror(errno) << std::endl;
+    return -1;
+  }
+
+  view.Reset(addr, size);
+
+  return 0;
+}
+
+void FileView::Unmap() {
+  if (addr_ != nullptr && munmap(addr_, size_) != 0) {
+    std::cerr << "Unable to unmap file: " << strerror(errno) << std::endl;
+  }
+
+  addr_ = nullptr;
+  size_ = 0;
+}
+
 int ApiC::GetExecutableDirectory(std::string &path) {
   char file_path[FILENAME_MAX + 1] = {0};
   ssize_t count = readlink("/proc/self/exe", file_path, FILENAME_MAX);
@@ -91,6 +344,39 @@ long long ApiC::GetFreeSpaceT(const std::string &path) {
   return fs.f_bsize * fs.f_bavail;
 }
 
+bool ApiC::IsMemoryFileSystem(const std::string &path) {
+  struct statfs fs;
+  if (statfs(path.c_str(), &fs) != 0) {
+    std::cerr << "Unable to get file system statistics: " << strerror(errno)
+              << std::endl;
+    return false;
+  }
+
+  return fs.f_type == TMPFS_MAGIC || fs.f_type == RAMFS_MAGIC;
+}
+
+long long ApiC::GetAvailableMemory() {
+  std::ifstream meminfo("/proc/meminfo");
+  std::string key;
+  long long value;
+  std::string unit;
+
+  while (meminfo >> key >> value >> unit) {
+    if (key == "MemAvailable:") {
+      return value * 1024;
+    }
+  }
+
+  /* kernels older than 3.14 do not report MemAvailable */
+  struct sysinfo info;
+  if (sysinfo(&info) != 0) {
+    std::cerr << "sysinfo failed: " << strerror(errno) << std::endl;
+    return -1;
+  }
+
+  return static_cast<long long>(info.freeram) * info.mem_unit;
+}
+
 int ApiC::CreateDirectoryT(const std::string &path) {
   if (mkdir(path.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH) == -1) {
     std::cerr << "mkdir failed: " << strerror(errno) << std::endl;
@@ -168,4 +454,122 @@ int ApiC::UnsetEnv(const std::string &name) {
   return unsetenv(name.c_str());
 }
 
+double ApiC::GetProcessCpuTime() {
+  double seconds = 0;
+  struct rusage usage;
+
+  for (int who : {RUSAGE_SELF, RUSAGE_CHILDREN}) {
+    if (getrusage(who, &usage) == 0) {
+      seconds += usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+                 (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    }
+  }
+
+  return seconds;
+}
+
+unsigned long ApiC::GetProcessIdT() {
+  return static_cast<unsigned long>(getpid());
+}
+
+int ApiC::GetNumaNode(const std::string &path) {
+  struct stat64 st;
+  if (stat64(path.c_str(), &st) != 0) {
+    return -1;
+  }
+
+  bool is_char = S_ISCHR(st.st_mode);
+  dev_t dev = is_char || S_ISBLK(st.st_mode) ? st.st_rdev : st.st_dev;
+  std::string sys_dev = std::string(is_char ? "/sys/dev/char/"
+                                            : "/sys/dev/block/") +
+                        std::to_string(major(dev)) + ":" +
+                        std::to_string(minor(dev));
+
+  /* partition has no device link, the one of its parent disk is used */
+  for (const char *attribute : {"/device/numa_node", "/../device/numa_node"}) {
+    std::ifstream numa_node(sys_dev + attribute);
+    int node;
+    if (numa_node >> node) {
+      return node < 0 ? -1 : node;
+    }
+  }
+
+  return -1;
+}
+
+int ApiC::GetOnlineNumaNodes(std::vector<unsigned> &nodes) {
+  nodes.clear();
+  std::ifstream online("/sys/devices/system/node/online");
+  std::string list;
+
+  if (!std::getline(online, list)) {
+    /* kernel without NUMA support */
+    nodes.emplace_back(0);
+    return 0;
+  }
+
+  if (ParseCpuList(list, nodes) != 0) {
+    std::cerr << "Invalid list of online NUMA nodes: " << list << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+int ApiC::GetNumaNodeCpus(unsigned node, std::vector<unsigned> &cpus) {
+  cpus.clear();
+  std::string path =
+      "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+  std::ifstream cpulist(path);
+  std::string list;
+
+  if (!cpulist.is_open()) {
+    if (node != 0 || DirectoryExists("/sys/devices/system/node")) {
+      std::cerr << "Unable to open " << path << std::endl;
+      return -1;
+    }
+    /* kernel without NUMA support, all CPUs belong to node 0 */
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    for (long cpu = 0; cpu < count; ++cpu) {
+      cpus.emplace_back(static_cast<unsigned>(cpu));
+    }
+    return 0;
+  }
+
+  std::getline(cpulist, list);
+  if (ParseCpuList(list, cpus) != 0) {
+    std::cerr << "Invalid CPU list of NUMA node " << node << ": " << list
+              << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+int ApiC::BindThreadToNumaNode(unsigned node) {
+  std::vector<unsigned> cpus;
+  if (GetNumaNodeCpus(node, cpus) != 0) {
+    return -1;
+  }
+  if (cpus.empty()) {
+    std::cerr << "NUMA node " << node << " has no CPUs" << std::endl;
+    return -1;
+  }
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (unsigned cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+
+  if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+    std::cerr << "sched_setaffinity failed: " << strerror(errno) << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
 #endif  // __linux__
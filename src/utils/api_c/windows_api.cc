@@ -101,6 +101,108 @@ err:
   return -1;
 }
 
+int ApiC::CloneFile(const std::string &src, const std::string &dst) {
+  if (!CopyFile(src.c_str(), dst.c_str(), FALSE)) {
+    std::cerr << "Unable to clone file " << src << ": " << GetLastError()
+              << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+int ApiC::GetFileStat(const std::string &path, FileStat &file_stat) {
+  struct _stat64 st;
+
+  if (_stat64(path.c_str(), &st) != 0) {
+    return -1;
+  }
+
+  file_stat.is_regular = (st.st_mode & _S_IFREG) != 0;
+  file_stat.is_directory = (st.st_mode & _S_IFDIR) != 0;
+  file_stat.size = st.st_size;
+  file_stat.mode = st.st_mode & PERMISSION_MASK;
+  file_stat.device = st.st_dev;
+
+  return 0;
+}
+
+int ApiC::ListDirectory(const std::string &path,
+                        std::vector<std::string> &entries) {
+  WIN32_FIND_DATA data;
+  HANDLE h = FindFirstFile((path + SEPARATOR + "*").c_str(), &data);
+
+  if (h == INVALID_HANDLE_VALUE) {
+    std::cerr << "Unable to open directory: " << GetLastError() << std::endl;
+    return -1;
+  }
+
+  entries.clear();
+
+  do {
+    if (strcmp(data.cFileName, ".") != 0 && strcmp(data.cFileName, "..") != 0) {
+      entries.emplace_back(data.cFileName);
+    }
+  } while (FindNextFile(h, &data));
+
+  FindClose(h);
+  return 0;
+}
+
+int ApiC::MapFile(const std::string &path, FileView &view) {
+  HANDLE h = CreateFile(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (h == INVALID_HANDLE_VALUE) {
+    std::cerr << "Unable to open file: " << GetLastError() << std::endl;
+    return -1;
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(h, &size)) {
+    std::cerr << "Unable to get file size: " << GetLastError() << std::endl;
+    CloseHandle(h);
+    return -1;
+  }
+
+  if (size.QuadPart == 0) {
+    view.Reset(nullptr, 0);
+    CloseHandle(h);
+    return 0;
+  }
+
+  HANDLE mapping =
+      CreateFileMapping(h, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(h);
+
+  if (mapping == nullptr) {
+    std::cerr << "Unable to create file mapping: " << GetLastError()
+              << std::endl;
+    return -1;
+  }
+
+  void *addr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+
+  if (addr == nullptr) {
+    std::cerr << "Unable to map file: " << GetLastError() << std::endl;
+    return -1;
+  }
+
+  view.Reset(addr, static_cast<size_t>(size.QuadPart));
+
+  return 0;
+}
+
+void FileView::Unmap() {
+  if (addr_ != nullptr && !UnmapViewOfFile(addr_)) {
+    std::cerr << "Unable to unmap file: " << GetLastError() << std::endl;
+  }
+
+  addr_ = nullptr;
+  size_ = 0;
+}
+
 int ApiC::GetExecutableDirectory(std::string &path) {
   char file_path[MAX_PATH + 1] = {0};
   auto count = GetModuleFileName(nullptr, file_path, MAX_PATH);
@@ -136,6 +238,29 @@ long long ApiC::GetFreeSpaceT(const std::string &path) {
   return total_number_of_free_bytes;
 }
 
+bool ApiC::IsMemoryFileSystem(const std::string &path) {
+  char volume[MAX_PATH];
+  if (GetVolumePathNameA(path.c_str(), volume, MAX_PATH) == 0) {
+    std::cerr << "Unable to get volume of path: " << GetLastError()
+              << std::endl;
+    return false;
+  }
+
+  return GetDriveTypeA(volume) == DRIVE_RAMDISK;
+}
+
+long long ApiC::GetAvailableMemory() {
+  MEMORYSTATUSEX status;
+  status.dwLength = sizeof(status);
+  if (GlobalMemoryStatusEx(&status) == 0) {
+    std::cerr << "Unable to get memory status: " << GetLastError()
+              << std::endl;
+    return -1;
+  }
+
+  return static_cast<long long>(status.ullAvailPhys);
+}
+
 int ApiC::CreateDirectoryT(const std::string &path) {
   BOOL ret = CreateDirectory(path.c_str(), nullptr);
 
@@ -206,6 +331,89 @@ int ApiC::UnsetEnv(const std::string &name) {
   return _putenv_s(name.c_str(), "");
 }
 
+double ApiC::GetProcessCpuTime() {
+  FILETIME creation, exit, kernel, user;
+  if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user) ==
+      0) {
+    return 0;
+  }
+
+  ULARGE_INTEGER kernel_time, user_time;
+  kernel_time.LowPart = kernel.dwLowDateTime;
+  kernel_time.HighPart = kernel.dwHighDateTime;
+  user_time.LowPart = user.dwLowDateTime;
+  user_time.HighPart = user.dwHighDateTime;
+
+  /* FILETIME is expressed in 100-nanosecond intervals */
+  return (kernel_time.QuadPart + user_time.QuadPart) / 1e7;
+}
+
+unsigned long ApiC::GetProcessIdT() {
+  return static_cast<unsigned long>(GetCurrentProcessId());
+}
+
+int ApiC::GetNumaNode(const std::string &path) {
+  /* volumes do not expose NUMA node of their device */
+  (void)path;
+  return -1;
+}
+
+int ApiC::GetOnlineNumaNodes(std::vector<unsigned> &nodes) {
+  ULONG highest;
+  if (!GetNumaHighestNodeNumber(&highest)) {
+    std::cerr << "GetNumaHighestNodeNumber failed: " << GetLastError()
+              << std::endl;
+    return -1;
+  }
+
+  nodes.clear();
+  for (ULONG node = 0; node <= highest; ++node) {
+    nodes.emplace_back(node);
+  }
+
+  return 0;
+}
+
+int ApiC::GetNumaNodeCpus(unsigned node, std::vector<unsigned> &cpus) {
+  GROUP_AFFINITY affinity;
+  if (!GetNumaNodeProcessorMaskEx(static_cast<USHORT>(node), &affinity)) {
+    std::cerr << "GetNumaNodeProcessorMaskEx failed: " << GetLastError()
+              << std::endl;
+    return -1;
+  }
+
+  const unsigned group_size = sizeof(KAFFINITY) * 8;
+  cpus.clear();
+  for (unsigned bit = 0; bit < group_size; ++bit) {
+    if (affinity.Mask & (static_cast<KAFFINITY>(1) << bit)) {
+      cpus.emplace_back(affinity.Group * group_size + bit);
+    }
+  }
+
+  return 0;
+}
+
+int ApiC::BindThreadToNumaNode(unsigned node) {
+  GROUP_AFFINITY affinity;
+  if (!GetNumaNodeProcessorMaskEx(static_cast<USHORT>(node), &affinity)) {
+    std::cerr << "GetNumaNodeProcessorMaskEx failed: " << GetLastError()
+              << std::endl;
+    return -1;
+  }
+  if (affinity.Mask == 0) {
+    std::cerr << "NUMA node " << node << " has no CPUs" << std::endl;
+    return -1;
+  }
+
+  if (!SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr)) {
+    std::cerr << "SetThreadGroupAffinity failed: " << GetLastError()
+              << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
 int ApiC::CreateFileT(const std::wstring &path, const std::wstring &content,
                       bool is_bom) {
   std::locale utf8_locale;
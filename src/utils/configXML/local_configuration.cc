@@ -44,5 +44,76 @@ int LocalConfiguration::FillConfigFields(pugi::xml_node &&root) {
     return -1;
   }
 
+  if (root.child("testDir").attribute("emulatedPmem").as_bool()) {
+    if (!ApiC::IsMemoryFileSystem(test_dir_)) {
+      std::cerr << "Emulated persistent memory requires testDir on RAM backed"
+                   " file system (e.g. /dev/shm). Please change testDir field"
+                   " value."
+                << std::endl;
+      return -1;
+    }
+
+    if (ApiC::SetEnv("PMEM_IS_PMEM_FORCE", "1") != 0) {
+      std::cerr << "Cannot set PMEM_IS_PMEM_FORCE environment variable"
+                << std::endl;
+      return -1;
+    }
+
+    emulated_pmem_ = true;
+  }
+
+  return SetPerfThresholds(root);
+}
+
+int LocalConfiguration::SetPerfThresholds(const pugi::xml_node &root) {
+  pugi::xml_node perf = root.child("perfThresholds");
+
+  if (perf.empty()) {
+    return 0;
+  }
+
+  perf_thresholds_.SetTolerance(
+      perf.attribute("tolerance").as_double(perf_thresholds_.GetTolerance()));
+
+  for (const auto &threshold : perf.children("threshold")) {
+    std::string name = threshold.attribute("name").value();
+    if (name.empty()) {
+      std::cerr << "Threshold without name in 'perfThresholds' node"
+                << std::endl;
+      return -1;
+    }
+    perf_thresholds_.Set(name, threshold.text().as_double());
+  }
+
+  /* thresholds given explicitly take precedence over baseline */
+  std::string baseline = perf.attribute("baseline").value();
+  if (!baseline.empty() && perf_thresholds_.LoadBaselineFile(baseline) != 0) {
+    return -1;
+  }
+
+  return 0;
+}
+
+int LocalConfiguration::CheckEmulatedPmemCapacity(
+    unsigned long long required) const {
+  if (!emulated_pmem_) {
+    return 0;
+  }
+
+  long long free_space = ApiC::GetFreeSpaceT(test_dir_);
+  long long memory = ApiC::GetAvailableMemory();
+  if (free_space < 0 || memory < 0) {
+    return -1;
+  }
+
+  if (static_cast<unsigned long long>(free_space) < required ||
+      static_cast<unsigned long long>(memory) < required) {
+    std::cerr << "Emulated persistent memory needs " << required
+              << " bytes for pools, test directory has " << free_space
+              << " bytes free and " << memory
+              << " bytes of memory are available" << std::endl;
+    return -1;
+  }
+
   return 0;
 }
@@ -36,6 +36,7 @@
 #include "api_c/api_c.h"
 #include "pugixml.hpp"
 #include "read_config.h"
+#include "test_utils/perf_thresholds.h"
 
 /*
  * LocalConfiguration -- class that provides access to configuration file.
@@ -44,6 +45,14 @@ class LocalConfiguration final : public ReadConfig<LocalConfiguration> {
  private:
   friend class ReadConfig<LocalConfiguration>;
   std::string test_dir_;
+  bool emulated_pmem_ = false;
+  PerfThresholds perf_thresholds_;
+  /*
+   * SetPerfThresholds -- reads thresholds of performance gates from optional
+   * perfThresholds node and baseline file it points to. Returns 0 on success,
+   * prints error message and returns -1 otherwise.
+   */
+  int SetPerfThresholds(const pugi::xml_node &root);
   /*
    * FillConfigFields -- checks that TestDir exists, creates folder 'pmdk_tests'
    * and assigns this path to test_dir_. Returns 0 on success, prints error
@@ -55,6 +64,36 @@ class LocalConfiguration final : public ReadConfig<LocalConfiguration> {
   const std::string &GetTestDir() {
     return this->test_dir_;
   }
+
+  /*
+   * IsPmemEmulated -- checks that tests run in emulated persistent memory
+   * mode (emulatedPmem attribute of testDir), i.e. on RAM backed file system
+   * with PMEM_IS_PMEM_FORCE=1 set, so that libpmem flushes data with CPU
+   * instructions instead of msync.
+   */
+  bool IsPmemEmulated() const {
+    return this->emulated_pmem_;
+  }
+
+  /*
+   * GetPmemMode -- returns name of persistent memory mode tests run in,
+   * intended for reports.
+   */
+  std::string GetPmemMode() const {
+    return emulated_pmem_ ? "emulated" : "native";
+  }
+
+  /*
+   * CheckEmulatedPmemCapacity -- in emulated persistent memory mode checks
+   * that both test directory and available memory can hold required bytes of
+   * pools. Returns 0 if so or in native mode, prints error message and returns
+   * -1 otherwise.
+   */
+  int CheckEmulatedPmemCapacity(unsigned long long required) const;
+
+  const PerfThresholds &GetPerfThresholds() const {
+    return this->perf_thresholds_;
+  }
 };
 
 #endif  // !PMDK_TESTS_SRC_UTILS_CONFIGXML_LOCAL_CONFIGURATION_H_
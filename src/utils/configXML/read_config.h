@@ -33,6 +33,7 @@
 #ifndef PMDK_TESTS_SRC_UTILS_CONFIGXML_READ_CONFIG_H_
 #define PMDK_TESTS_SRC_UTILS_CONFIGXML_READ_CONFIG_H_
 
+#include <cstdlib>
 #include "api_c/api_c.h"
 #include "non_copyable/non_copyable.h"
 #include "pugixml.hpp"
@@ -64,7 +65,11 @@ class ReadConfig : public NonCopyable {
 template <class DerivedConfig>
 inline int ReadConfig<DerivedConfig>::SetTestDir(const pugi::xml_node &root,
                                                  std::string &test_dir) {
-  test_dir = root.child("testDir").text().get();
+  /* test runner may give every process (e.g. test shard) its own directory */
+  const char *env_test_dir = std::getenv("PMDK_TESTS_DIR");
+  test_dir = env_test_dir != nullptr && env_test_dir[0] != '\0'
+                 ? env_test_dir
+                 : root.child("testDir").text().get();
 
   if (test_dir.empty()) {
     std::cerr << "TestDir field is empty. Please change testDir field value."
@@ -79,8 +84,10 @@ inline int ReadConfig<DerivedConfig>::SetTestDir(const pugi::xml_node &root,
     return -1;
   }
 
+  /* directory may be created concurrently by other test process */
   if (!ApiC::DirectoryExists((test_dir + SEPARATOR + "pmdk_tests")) &&
-      ApiC::CreateDirectoryT((test_dir + SEPARATOR + "pmdk_tests")) != 0) {
+      ApiC::CreateDirectoryT((test_dir + SEPARATOR + "pmdk_tests")) != 0 &&
+      !ApiC::DirectoryExists((test_dir + SEPARATOR + "pmdk_tests"))) {
     return -1;
   }
 
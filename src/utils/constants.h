@@ -53,13 +53,19 @@ const std::string SEPARATOR = "/";
 static const size_t KIBIBYTE = 1 << 10;
 static const size_t MEBIBYTE = KIBIBYTE << 10;
 static const size_t GIGIBYTE = MEBIBYTE << 10;
+static const size_t TEBIBYTE = GIGIBYTE << 10;
+static const size_t PEBIBYTE = TEBIBYTE << 10;
 static const size_t KILOBYTE = 1000;
 static const size_t MEGABYTE = KILOBYTE * 1000;
 static const size_t GIGABYTE = MEGABYTE * 1000;
+static const size_t TERABYTE = GIGABYTE * 1000;
+static const size_t PETABYTE = TERABYTE * 1000;
 
 static const std::map<std::string, size_t> SIZES{
     {"KiB", KIBIBYTE}, {"MiB", MEBIBYTE}, {"GiB", GIGIBYTE},
-    {"KB", KILOBYTE},  {"MB", MEGABYTE},  {"GB", GIGABYTE},
-    {"K", KIBIBYTE},   {"M", MEBIBYTE},   {"G", GIGIBYTE}};
+    {"TiB", TEBIBYTE}, {"PiB", PEBIBYTE}, {"KB", KILOBYTE},
+    {"MB", MEGABYTE},  {"GB", GIGABYTE},  {"TB", TERABYTE},
+    {"PB", PETABYTE},  {"K", KIBIBYTE},   {"M", MEBIBYTE},
+    {"G", GIGIBYTE},   {"T", TEBIBYTE},   {"P", PEBIBYTE}};
 
 #endif  // !PMDK_TESTS_SRC_UTILS_CONSTANTS_H_
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "pool_corruptor.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "api_c/api_c.h"
+
+namespace {
+/* layout of PMDK pools, offsets in bytes from the beginning of pool file */
+const unsigned long long POOL_HDR_SIZE = 4096;
+const size_t SIGNATURE_SIZE = 8;
+const char OBJ_SIGNATURE[] = "PMEMOBJ";
+const char BLK_SIGNATURE[] = "PMEMBLK";
+const char LOG_SIGNATURE[] = "PMEMLOG";
+
+/* pmemobj descriptor follows pool header, heap_offset follows the layout */
+const unsigned long long OBJ_HEAP_OFFSET = POOL_HDR_SIZE + 1024 + 16;
+const unsigned long long HEAP_HEADER_SIZE = 1024;
+const unsigned long long ZONE_HEADER_SIZE = 64;
+const unsigned long long ZONE_SIZE_IDX_OFFSET = 4;
+const unsigned long long CHUNK_HEADER_SIZE = 8;
+
+/* the first BTT arena starts at the first page after pmemblk descriptor */
+const unsigned long long BLK_ARENA_OFFSET = 2 * POOL_HDR_SIZE;
+const unsigned long long BTT_INFO_SIZE = 4096;
+const unsigned long long BTT_NFREE_OFFSET = 72;
+const unsigned long long BTT_FLOGOFF_OFFSET = 104;
+const unsigned long long BTT_FLOG_PAIR_SIZE = 64;
+
+/* pmemlog descriptor holds start, end and write offsets of the log area */
+const unsigned long long LOG_DESCRIPTOR_OFFSET = POOL_HDR_SIZE;
+const unsigned long long LOG_DESCRIPTOR_SIZE = 3 * sizeof(uint64_t);
+
+template <typename T>
+bool ReadAt(std::ifstream &file, unsigned long long offset, T &value) {
+  return static_cast<bool>(
+      file.seekg(static_cast<std::streamoff>(offset)) &&
+      file.read(reinterpret_cast<char *>(&value), sizeof(value)));
+}
+
+bool HasSignature(const char *signature, const char *expected) {
+  return std::memcmp(signature, expected, SIGNATURE_SIZE) == 0;
+}
+}  // namespace
+
+int PoolCorruptor::Locate(CorruptionTarget target,
+                          CorruptionRange &range) const {
+  std::ifstream file(path_, std::ios::binary);
+  char signature[SIGNATURE_SIZE];
+
+  if (!file.read(signature, sizeof(signature))) {
+    std::cerr << "Cannot read pool header of " << path_ << std::endl;
+    return -1;
+  }
+
+  bool located = false;
+  switch (target) {
+    case CorruptionTarget::PoolHeader:
+      range.offset = 0;
+      range.length = POOL_HDR_SIZE;
+      located = true;
+      break;
+    case CorruptionTarget::BttInfo:
+      range.offset = BLK_ARENA_OFFSET;
+      range.length = BTT_INFO_SIZE;
+      located = HasSignature(signature, BLK_SIGNATURE);
+      break;
+    case CorruptionTarget::BttFlog: {
+      uint32_t nfree;
+      uint64_t flogoff;
+      located =
+          HasSignature(signature, BLK_SIGNATURE) &&
+          ReadAt(file, BLK_ARENA_OFFSET + BTT_NFREE_OFFSET, nfree) &&
+          ReadAt(file, BLK_ARENA_OFFSET + BTT_FLOGOFF_OFFSET, flogoff);
+      if (located) {
+        range.offset = BLK_ARENA_OFFSET + flogoff;
+        range.length = nfree * BTT_FLOG_PAIR_SIZE;
+      }
+      break;
+    }
+    case CorruptionTarget::HeapZone: {
+      uint64_t heap_offset;
+      uint32_t size_idx;
+      located = HasSignature(signature, OBJ_SIGNATURE) &&
+                ReadAt(file, OBJ_HEAP_OFFSET, heap_offset) &&
+                ReadAt(file,
+                       heap_offset + HEAP_HEADER_SIZE + ZONE_SIZE_IDX_OFFSET,
+                       size_idx);
+      if (located) {
+        range.offset = heap_offset + HEAP_HEADER_SIZE;
+        range.length = ZONE_HEADER_SIZE + size_idx * CHUNK_HEADER_SIZE;
+      }
+      break;
+    }
+    case CorruptionTarget::LogDescriptor:
+      range.offset = LOG_DESCRIPTOR_OFFSET;
+      range.length = LOG_DESCRIPTOR_SIZE;
+      located = HasSignature(signature, LOG_SIGNATURE);
+      break;
+  }
+
+  if (!located) {
+    std::cerr << "Cannot locate corruption target in " << path_ << std::endl;
+    return -1;
+  }
+
+  long long file_size = ApiC::GetFileSize(path_);
+  if (file_size < 0 || range.offset + range.length >
+                           static_cast<unsigned long long>(file_size)) {
+    std::cerr << "Corruption target exceeds file " << path_ << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+int PoolCorruptor::Corrupt(CorruptionTarget target, CorruptionMode mode,
+                           unsigned long long extent, CorruptionRange &range,
+                           unsigned seed) const {
+  if (Locate(target, range) != 0) {
+    return -1;
+  }
+
+  if (extent < range.length) {
+    range.length = extent;
+  }
+
+  return CorruptRange(range, mode, seed);
+}
+
+int PoolCorruptor::CorruptRange(const CorruptionRange &range,
+                                CorruptionMode mode, unsigned seed) const {
+  std::fstream file(path_, std::ios::in | std::ios::out | std::ios::binary);
+  std::vector<char> data(range.length, 0);
+  auto offset = static_cast<std::streamoff>(range.offset);
+
+  if (mode == CorruptionMode::FlipBits) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> bit(0, 7);
+
+    if (!file.seekg(offset) || !file.read(data.data(), data.size())) {
+      std::cerr << "Cannot read range of file " << path_ << std::endl;
+      return -1;
+    }
+    for (auto &byte : data) {
+      byte = static_cast<char>(byte ^ (1 << bit(generator)));
+    }
+  }
+
+  if (!file.seekp(offset) || !file.write(data.data(), data.size()) ||
+      !file.flush()) {
+    std::cerr << "Cannot write range of file " << path_ << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
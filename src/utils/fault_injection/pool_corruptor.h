@@ -0,0 +1,108 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_FAULT_INJECTION_POOL_CORRUPTOR_H_
+#define PMDK_TESTS_SRC_UTILS_FAULT_INJECTION_POOL_CORRUPTOR_H_
+
+#include <string>
+#include "non_copyable/non_copyable.h"
+
+/*
+ * CorruptionTarget -- on-media structure of pool to be damaged.
+ */
+enum class CorruptionTarget {
+  /* pool header at the beginning of any pool file or pool set part */
+  PoolHeader,
+  /* info header of the first BTT arena of pmemblk pool */
+  BttInfo,
+  /* flog of the first BTT arena of pmemblk pool */
+  BttFlog,
+  /* zone header and chunk headers of the first zone of pmemobj heap */
+  HeapZone,
+  /* start, end and write offsets delimiting log area of pmemlog pool */
+  LogDescriptor
+};
+
+enum class CorruptionMode { Zero, FlipBits };
+
+/*
+ * CorruptionRange -- range of file holding corruption target.
+ */
+struct CorruptionRange {
+  unsigned long long offset = 0;
+  unsigned long long length = 0;
+};
+
+/*
+ * PoolCorruptor -- damages on-media structures of pmemobj, pmemblk and
+ * pmemlog pools on file level. Location of each structure is read from the
+ * descriptors stored in the file, so that it follows layout of the pool
+ * actually created. Targets other than pool header are looked up in the file
+ * holding pool descriptor, i.e. the first part of pool set.
+ */
+class PoolCorruptor final : NonCopyable {
+ private:
+  std::string path_;
+
+ public:
+  explicit PoolCorruptor(const std::string &path) : path_(path) {
+  }
+
+  const std::string &GetPath() const {
+    return path_;
+  }
+
+  /*
+   * Locate -- finds range of file holding given target. Returns 0 on success,
+   * prints error message and returns -1 otherwise.
+   */
+  int Locate(CorruptionTarget target, CorruptionRange &range) const;
+
+  /*
+   * Corrupt -- damages up to extent bytes at the beginning of given target,
+   * either zeroing them or flipping one bit chosen with given seed in each
+   * byte. Stores damaged range in range. Returns 0 on success, prints error
+   * message and returns -1 otherwise.
+   */
+  int Corrupt(CorruptionTarget target, CorruptionMode mode,
+              unsigned long long extent, CorruptionRange &range,
+              unsigned seed = 0) const;
+
+  /*
+   * CorruptRange -- damages given range of the file. Returns 0 on success,
+   * prints error message and returns -1 otherwise.
+   */
+  int CorruptRange(const CorruptionRange &range, CorruptionMode mode,
+                   unsigned seed = 0) const;
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_FAULT_INJECTION_POOL_CORRUPTOR_H_
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/* msb of 64-bit value shifts it by at most 64 - SUB_BUCKET_BITS */
+const size_t BUCKET_COUNT =
+    (64 - Histogram::SUB_BUCKET_BITS + 2) * (Histogram::SUB_BUCKETS / 2);
+
+const double JSON_PERCENTILES[] = {50, 90, 99, 99.9, 99.99};
+}  // namespace
+
+const unsigned Histogram::SUB_BUCKET_BITS;
+const uint64_t Histogram::SUB_BUCKETS;
+
+Histogram::Histogram() : counts_(BUCKET_COUNT, 0) {
+}
+
+uint64_t Histogram::GetBucketHighestValue(size_t index) {
+  if (index < SUB_BUCKETS) {
+    return index;
+  }
+  unsigned shift = static_cast<unsigned>(index / HALF - 1);
+  uint64_t sub_bucket = index - shift * HALF;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+void Histogram::Add(const Histogram &other) {
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    counts_[i] += other.counts_[i];
+  }
+  total_count_ += other.total_count_;
+  sum_ += other.sum_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+void Histogram::Reset() {
+  std::fill(counts_.begin(), counts_.end(), 0);
+  total_count_ = 0;
+  min_ = std::numeric_limits<uint64_t>::max();
+  max_ = 0;
+  sum_ = 0;
+}
+
+uint64_t Histogram::GetPercentile(double percent) const {
+  if (total_count_ == 0) {
+    return 0;
+  }
+
+  percent = std::min(std::max(percent, 0.0), 100.0);
+  uint64_t rank =
+      static_cast<uint64_t>(std::ceil(percent / 100 * total_count_));
+  rank = std::max<uint64_t>(rank, 1);
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      return std::max(GetMin(), std::min(GetBucketHighestValue(i), max_));
+    }
+  }
+
+  return max_;
+}
+
+void Histogram::WriteCsv(std::ostream &os) const {
+  uint64_t seen = 0;
+
+  os << "value,count,percentile" << std::endl;
+  ForEachBucket([&](uint64_t value, uint64_t count) {
+    seen += count;
+    os << value << "," << count << ","
+       << 100.0 * seen / total_count_ << std::endl;
+  });
+}
+
+void Histogram::WriteJson(std::ostream &os) const {
+  os << "{\"count\": " << total_count_ << ", \"min\": " << GetMin()
+     << ", \"mean\": " << GetMean() << ", \"max\": " << GetMax();
+
+  for (double percent : JSON_PERCENTILES) {
+    os << ", \"p" << percent << "\": " << GetPercentile(percent);
+  }
+
+  os << ", \"buckets\": [";
+  bool first = true;
+  ForEachBucket([&](uint64_t value, uint64_t count) {
+    os << (first ? "" : ", ") << "[" << value << ", " << count << "]";
+    first = false;
+  });
+  os << "]}";
+}
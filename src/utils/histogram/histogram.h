@@ -0,0 +1,161 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_HISTOGRAM_HISTOGRAM_H_
+#define PMDK_TESTS_SRC_UTILS_HISTOGRAM_HISTOGRAM_H_
+
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <vector>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif  // _MSC_VER
+
+/*
+ * Histogram -- log-bucketed histogram of unsigned values (e.g. latencies in
+ * nanoseconds). Each power of two range is split into SUB_BUCKETS / 2 linear
+ * buckets, so relative error of reported values is below 2 / SUB_BUCKETS.
+ * Recording does not allocate nor synchronize: each thread should record into
+ * its own instance, which are merged with Add() afterwards.
+ */
+class Histogram final {
+ public:
+  static const unsigned SUB_BUCKET_BITS = 7;
+  static const uint64_t SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;
+
+ private:
+  static const uint64_t HALF = SUB_BUCKETS / 2;
+  std::vector<uint64_t> counts_;
+  uint64_t total_count_ = 0;
+  uint64_t min_ = std::numeric_limits<uint64_t>::max();
+  uint64_t max_ = 0;
+  double sum_ = 0;
+
+  static unsigned GetMostSignificantBit(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return index;
+#else
+    return 63 - __builtin_clzll(value);
+#endif  // _MSC_VER
+  }
+
+  /*
+   * GetBucketIndex -- values below SUB_BUCKETS have buckets of their own,
+   * larger ones are shifted right until they fit in upper half of sub
+   * buckets, and the shift selects the range.
+   */
+  static size_t GetBucketIndex(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+      return static_cast<size_t>(value);
+    }
+    unsigned shift = GetMostSignificantBit(value) - (SUB_BUCKET_BITS - 1);
+    return static_cast<size_t>(shift * HALF + (value >> shift));
+  }
+
+  /*
+   * GetBucketHighestValue -- returns the largest value counted in bucket.
+   */
+  static uint64_t GetBucketHighestValue(size_t index);
+
+ public:
+  Histogram();
+
+  void Record(uint64_t value) {
+    ++counts_[GetBucketIndex(value)];
+    ++total_count_;
+    sum_ += value;
+    if (value < min_) {
+      min_ = value;
+    }
+    if (value > max_) {
+      max_ = value;
+    }
+  }
+
+  /*
+   * Add -- merges samples recorded in other histogram into this one.
+   */
+  void Add(const Histogram &other);
+
+  void Reset();
+
+  uint64_t GetCount() const {
+    return total_count_;
+  }
+  uint64_t GetMin() const {
+    return total_count_ == 0 ? 0 : min_;
+  }
+  uint64_t GetMax() const {
+    return max_;
+  }
+  double GetMean() const {
+    return total_count_ == 0 ? 0 : sum_ / total_count_;
+  }
+
+  /*
+   * GetPercentile -- returns value below or equal to which given percent of
+   * recorded values fall, within bucket precision. Returns 0 if histogram is
+   * empty.
+   */
+  uint64_t GetPercentile(double percent) const;
+
+  /*
+   * ForEachBucket -- calls func(highest_value, count) for each non-empty
+   * bucket in ascending order.
+   */
+  template <typename Func>
+  void ForEachBucket(Func func) const {
+    for (size_t i = 0; i < counts_.size(); ++i) {
+      if (counts_[i] != 0) {
+        uint64_t value = GetBucketHighestValue(i);
+        func(value < max_ ? value : max_, counts_[i]);
+      }
+    }
+  }
+
+  /*
+   * WriteCsv -- writes "value,count,percentile" line for each non-empty
+   * bucket, preceded by header line.
+   */
+  void WriteCsv(std::ostream &os) const;
+
+  /*
+   * WriteJson -- writes JSON object with count, min, mean, max, common
+   * percentiles and array of [value, count] pairs of non-empty buckets.
+   */
+  void WriteJson(std::ostream &os) const;
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_HISTOGRAM_HISTOGRAM_H_
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "perf_counters.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // __linux__
+
+namespace {
+const char *const EVENT_NAMES[] = {"cycles", "instructions", "llc_misses",
+                                   "dtlb_misses", "stalled_cycles_backend"};
+
+#ifdef __linux__
+struct EventConfig {
+  __u32 type;
+  __u64 config;
+};
+
+const __u64 CACHE_READ_MISS = (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+const EventConfig EVENT_CONFIGS[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | CACHE_READ_MISS},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | CACHE_READ_MISS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND}};
+
+int OpenEvent(const EventConfig &event) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  /* user space only, as allowed with default perf_event_paranoid */
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+}
+#endif  // __linux__
+}  // namespace
+
+PerfCounters::PerfCounters() {
+  fds_.fill(-1);
+  values_.fill(0);
+  valid_.fill(false);
+  Open();
+}
+
+PerfCounters::~PerfCounters() {
+  Close();
+}
+
+void PerfCounters::Open() {
+#ifdef __linux__
+  for (size_t i = 0; i < EVENT_COUNT; ++i) {
+    fds_[i] = OpenEvent(EVENT_CONFIGS[i]);
+    if (fds_[i] < 0 && error_.empty()) {
+      error_ = std::string(EVENT_NAMES[i]) + ": " + strerror(errno);
+    }
+  }
+#else
+  error_ = "perf_event_open is not supported on this platform";
+#endif  // __linux__
+}
+
+void PerfCounters::Close() {
+#ifdef __linux__
+  for (int &fd : fds_) {
+    if (fd >= 0) {
+      close(fd);
+      fd = -1;
+    }
+  }
+#endif  // __linux__
+}
+
+bool PerfCounters::IsAvailable() const {
+  for (int fd : fds_) {
+    if (fd >= 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PerfCounters::Start() {
+  valid_.fill(false);
+  /* reset does not clear counts inherited from threads which already ended,
+   * so counters are opened anew */
+  Close();
+  Open();
+#ifdef __linux__
+  for (int fd : fds_) {
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif  // __linux__
+}
+
+void PerfCounters::Stop() {
+#ifdef __linux__
+  for (size_t i = 0; i < EVENT_COUNT; ++i) {
+    if (fds_[i] < 0) {
+      continue;
+    }
+    ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+
+    /* value, time enabled, time running */
+    __u64 data[3];
+    if (read(fds_[i], data, sizeof(data)) != sizeof(data) || data[2] == 0) {
+      continue;
+    }
+    values_[i] = static_cast<double>(data[0]) * data[1] / data[2];
+    valid_[i] = true;
+  }
+
+  if (IsAvailable() && error_.empty() &&
+      std::find(valid_.begin(), valid_.end(), true) == valid_.end()) {
+    error_ = "counters were not scheduled";
+  }
+#endif  // __linux__
+}
+
+bool PerfCounters::GetValue(PerfEvent event, double &value) const {
+  size_t i = static_cast<size_t>(event);
+  if (i >= EVENT_COUNT || !valid_[i]) {
+    return false;
+  }
+  value = values_[i];
+  return true;
+}
+
+const char *PerfCounters::GetName(PerfEvent event) {
+  size_t i = static_cast<size_t>(event);
+  return i < EVENT_COUNT ? EVENT_NAMES[i] : "unknown";
+}
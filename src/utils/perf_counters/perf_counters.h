@@ -0,0 +1,122 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_PERF_COUNTERS_PERF_COUNTERS_H_
+#define PMDK_TESTS_SRC_UTILS_PERF_COUNTERS_PERF_COUNTERS_H_
+
+#include <array>
+#include <string>
+#include "non_copyable/non_copyable.h"
+
+enum class PerfEvent {
+  cycles,
+  instructions,
+  llc_misses,
+  dtlb_misses,
+  stalled_cycles_backend,
+  count
+};
+
+/*
+ * PerfCounters -- hardware performance counters of the thread which created
+ * the object and of threads it starts while counting, read with
+ * perf_event_open. Counters the CPU, kernel or container does not provide
+ * are left out instead of failing, so that counting can always be wrapped
+ * around measured region. Threads started while counting have to finish
+ * before Stop() to be accounted.
+ */
+class PerfCounters final : NonCopyable {
+ private:
+  static const size_t EVENT_COUNT = static_cast<size_t>(PerfEvent::count);
+  std::array<int, EVENT_COUNT> fds_;
+  std::array<double, EVENT_COUNT> values_;
+  std::array<bool, EVENT_COUNT> valid_;
+  std::string error_;
+
+  void Open();
+  void Close();
+
+ public:
+  PerfCounters();
+  ~PerfCounters();
+
+  /*
+   * IsAvailable -- returns true if at least one counter could be opened.
+   */
+  bool IsAvailable() const;
+
+  /*
+   * GetError -- returns reason the first unavailable counter could not be
+   * opened.
+   */
+  const std::string &GetError() const {
+    return error_;
+  }
+
+  /*
+   * Start -- opens counters anew, so that events of threads counted
+   * previously are not carried over, and enables available ones.
+   */
+  void Start();
+
+  /*
+   * Stop -- disables counters and reads their values, scaled up if kernel
+   * multiplexed them.
+   */
+  void Stop();
+
+  /*
+   * GetValue -- gets value of event counted between last Start() and
+   * Stop(). Returns false if event was not counted.
+   */
+  bool GetValue(PerfEvent event, double &value) const;
+
+  static const char *GetName(PerfEvent event);
+
+  /*
+   * Scope -- counts events for lifetime of the object.
+   */
+  class Scope final : NonCopyable {
+   private:
+    PerfCounters &counters_;
+
+   public:
+    explicit Scope(PerfCounters &counters) : counters_(counters) {
+      counters_.Start();
+    }
+    ~Scope() {
+      counters_.Stop();
+    }
+  };
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_PERF_COUNTERS_PERF_COUNTERS_H_
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "pool_image_cache.h"
+
+std::string PoolImageCache::GetImagePath(size_t image, size_t part) const {
+  return cache_dir_ + "image" + std::to_string(image) + "_part" +
+         std::to_string(part);
+}
+
+int PoolImageCache::StoreImage(const std::string &key,
+                               const std::vector<std::string> &paths) {
+  if (!ApiC::DirectoryExists(cache_dir_) &&
+      ApiC::CreateDirectoryT(cache_dir_) != 0) {
+    return -1;
+  }
+
+  std::vector<std::string> image;
+  for (const auto &path : paths) {
+    image.emplace_back(GetImagePath(images_.size(), image.size()));
+    if (ApiC::CloneFile(path, image.back()) != 0) {
+      for (const auto &stored : image) {
+        ApiC::RemoveFile(stored);
+      }
+      return -1;
+    }
+  }
+
+  images_.emplace(key, std::move(image));
+  return 0;
+}
+
+int PoolImageCache::GetPool(const std::string &key,
+                            const std::vector<std::string> &paths,
+                            const std::function<int()> &create) {
+  auto it = images_.find(key);
+
+  if (it == images_.end()) {
+    if (create() != 0) {
+      return -1;
+    }
+    /* pool is usable even if it could not be cached */
+    StoreImage(key, paths);
+    return 0;
+  }
+
+  if (it->second.size() != paths.size()) {
+    std::cerr << "Pool image consists of " << it->second.size()
+              << " files, requested " << paths.size() << std::endl;
+    return -1;
+  }
+
+  for (size_t i = 0; i < paths.size(); ++i) {
+    if (ApiC::CloneFile(it->second[i], paths[i]) != 0) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+int PoolImageCache::Clear() {
+  images_.clear();
+
+  if (!ApiC::DirectoryExists(cache_dir_)) {
+    return 0;
+  }
+
+  if (ApiC::CleanDirectory(cache_dir_) != 0) {
+    return -1;
+  }
+
+  return ApiC::RemoveDirectoryT(cache_dir_);
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_POOL_CACHE_POOL_IMAGE_CACHE_H_
+#define PMDK_TESTS_SRC_UTILS_POOL_CACHE_POOL_IMAGE_CACHE_H_
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "api_c/api_c.h"
+#include "non_copyable/non_copyable.h"
+
+/*
+ * PoolImageCache -- stores golden images of pools created once during test
+ * run. Subsequent requests for pool described by the same key are served by
+ * cloning the image instead of creating pool from scratch.
+ */
+class PoolImageCache final : NonCopyable {
+ private:
+  std::string cache_dir_;
+  std::map<std::string, std::vector<std::string>> images_;
+
+  std::string GetImagePath(size_t image, size_t part) const;
+  int StoreImage(const std::string &key,
+                 const std::vector<std::string> &paths);
+
+ public:
+  explicit PoolImageCache(const std::string &cache_dir)
+      : cache_dir_(cache_dir) {
+  }
+
+  const std::string &GetCacheDir() const {
+    return cache_dir_;
+  }
+
+  bool Contains(const std::string &key) const {
+    return images_.find(key) != images_.end();
+  }
+
+  /*
+   * GetPool -- places pool described by key in given paths. On the first
+   * request the pool is created by create function and its files are stored
+   * as golden image, following requests clone the stored image. Paths of
+   * multi-file pools have to be passed in the same order on every request.
+   * Returns 0 on success, prints error message and returns -1 otherwise.
+   */
+  int GetPool(const std::string &key, const std::vector<std::string> &paths,
+              const std::function<int()> &create);
+
+  /*
+   * Clear -- removes all stored images along with cache directory. Returns 0
+   * on success, prints error message and returns -1 otherwise.
+   */
+  int Clear();
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_POOL_CACHE_POOL_IMAGE_CACHE_H_
@@ -0,0 +1,280 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "pool_info.h"
+#include <algorithm>
+#include <iostream>
+#include "api_c/api_c.h"
+
+namespace {
+bool Contains(const StringView &text, const StringView &pattern) {
+  return std::search(text.begin(), text.end(), pattern.begin(),
+                     pattern.end()) != text.end();
+}
+
+bool IsIndent(char c) {
+  return c == ' ' || c == '\t';
+}
+}  // namespace
+
+void PoolInfo::Parse(std::string &&output) {
+  view_.Unmap();
+  content_ = std::move(output);
+  data_ = StringView(content_);
+  Index();
+}
+
+int PoolInfo::ParseFile(const std::string &path) {
+  content_.clear();
+  if (ApiC::MapFile(path, view_) != 0) {
+    return -1;
+  }
+
+  data_ = StringView(view_.GetData(), view_.GetSize());
+  Index();
+  return 0;
+}
+
+void PoolInfo::Index() {
+  std::vector<size_t> open;
+  StringView rest = data_;
+
+  sections_.clear();
+  fields_.clear();
+
+  while (!rest.IsEmpty()) {
+    StringView line = rest.PopLine();
+    size_t indent = 0;
+    while (indent < line.GetSize() && IsIndent(line[indent])) {
+      ++indent;
+    }
+
+    StringView text = line.Substr(indent).Trim();
+    size_t colon = text.Find(':');
+    if (colon == StringView::npos) {
+      continue;
+    }
+
+    /* field names are padded to align values, section titles are not */
+    StringView key = text.Substr(0, colon);
+    StringView value = text.Substr(colon + 1).Trim();
+    bool is_title =
+        value.IsEmpty() && !key.IsEmpty() && !StringView::IsSpace(key.Back());
+    key = key.Trim();
+
+    if (is_title) {
+      while (!open.empty() && sections_[open.back()].indent >= indent) {
+        open.pop_back();
+      }
+      sections_.push_back({key, indent, open.empty() ? npos : open.back(),
+                           fields_.size(), 0});
+      open.push_back(sections_.size() - 1);
+      continue;
+    }
+
+    if (open.empty()) {
+      sections_.push_back({StringView(), 0, npos, fields_.size(), 0});
+      open.push_back(sections_.size() - 1);
+    }
+    fields_.push_back({key, value});
+    ++sections_[open.back()].field_count;
+  }
+}
+
+const InfoSection *PoolInfo::FindSection(const StringView &prefix,
+                                         const InfoSection *after) const {
+  size_t i = after == nullptr ? 0 : after - sections_.data() + 1;
+
+  for (; i < sections_.size(); ++i) {
+    if (sections_[i].title.StartsWith(prefix)) {
+      return &sections_[i];
+    }
+  }
+
+  return nullptr;
+}
+
+StringView PoolInfo::GetValue(const InfoSection &section,
+                              const StringView &key) const {
+  for (size_t i = 0; i < section.field_count; ++i) {
+    const InfoField &field = fields_[section.first_field + i];
+    if (field.key == key) {
+      return field.value;
+    }
+  }
+
+  return StringView();
+}
+
+bool PoolInfo::GetNumber(const InfoSection &section, const StringView &key,
+                         unsigned long long &number) const {
+  return ToNumber(GetValue(section, key), number);
+}
+
+bool PoolInfo::ToNumber(const StringView &text, unsigned long long &number) {
+  unsigned base = 10;
+  size_t pos = 0;
+
+  if (text.StartsWith("0x") || text.StartsWith("0X")) {
+    base = 16;
+    pos = 2;
+  }
+
+  size_t begin = pos;
+  number = 0;
+  for (; pos < text.GetSize(); ++pos) {
+    char c = text[pos];
+    unsigned digit;
+    if (c >= '0' && c <= '9') {
+      digit = c - '0';
+    } else if (base == 16 && c >= 'a' && c <= 'f') {
+      digit = c - 'a' + 10;
+    } else if (base == 16 && c >= 'A' && c <= 'F') {
+      digit = c - 'A' + 10;
+    } else {
+      break;
+    }
+    number = number * base + digit;
+  }
+
+  return pos > begin;
+}
+
+int PoolInfo::GetSection(const StringView &title,
+                         const InfoSection *&section) const {
+  section = FindSection(title);
+  if (section == nullptr) {
+    std::cerr << "Section " << title.ToString()
+              << " not found in pmempool info output" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+int PoolInfo::GetPoolHeader(PoolHeaderInfo &header) const {
+  const InfoSection *section;
+  if (GetSection("POOL Header", section) != 0) {
+    return -1;
+  }
+
+  header.signature = GetValue(*section, "Signature");
+  GetNumber(*section, "Major", header.major);
+  header.uuid = GetValue(*section, "UUID");
+  header.checksum_ok = Contains(GetValue(*section, "Checksum"), "[OK]");
+  return 0;
+}
+
+int PoolInfo::GetObjHeader(ObjHeaderInfo &header) const {
+  const InfoSection *section;
+  if (GetSection("PMEM OBJ Header", section) != 0) {
+    return -1;
+  }
+
+  header.layout = GetValue(*section, "Layout");
+  GetNumber(*section, "Lanes offset", header.lanes_offset);
+  GetNumber(*section, "Number of lanes", header.nlanes);
+  GetNumber(*section, "Heap offset", header.heap_offset);
+  GetNumber(*section, "Heap size", header.heap_size);
+  GetNumber(*section, "Root offset", header.root_offset);
+  return 0;
+}
+
+int PoolInfo::GetBlkHeader(BlkHeaderInfo &header) const {
+  const InfoSection *section;
+  if (GetSection("PMEM BLK Header", section) != 0) {
+    return -1;
+  }
+
+  GetNumber(*section, "Block size", header.block_size);
+  header.is_zeroed = GetValue(*section, "Is zeroed") == "true";
+  return 0;
+}
+
+int PoolInfo::GetLogHeader(LogHeaderInfo &header) const {
+  const InfoSection *section;
+  if (GetSection("PMEM LOG Header", section) != 0) {
+    return -1;
+  }
+
+  GetNumber(*section, "Start offset", header.start_offset);
+  GetNumber(*section, "End offset", header.end_offset);
+  GetNumber(*section, "Write offset", header.write_offset);
+  return 0;
+}
+
+int PoolInfo::GetBttInfoHeaders(std::vector<BttInfoHeader> &headers) const {
+  const StringView title = "PMEM BLK BTT Info Header";
+  const InfoSection *section = nullptr;
+
+  headers.clear();
+  while ((section = FindSection(title, section)) != nullptr) {
+    BttInfoHeader header;
+    GetNumber(*section, "External LBA size", header.external_lba_size);
+    GetNumber(*section, "External LBA count", header.external_lba_count);
+    GetNumber(*section, "Internal LBA size", header.internal_lba_size);
+    GetNumber(*section, "Internal LBA count", header.internal_lba_count);
+    GetNumber(*section, "Free blocks", header.free_blocks);
+    GetNumber(*section, "Next arena offset", header.next_arena_offset);
+    headers.push_back(header);
+  }
+
+  if (headers.empty()) {
+    std::cerr << "Section " << title.ToString()
+              << " not found in pmempool info output" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+int PoolInfo::GetZones(std::vector<ZoneInfo> &zones) const {
+  const StringView title = "Zone ";
+  const InfoSection *section = nullptr;
+
+  zones.clear();
+  while ((section = FindSection(title, section)) != nullptr) {
+    ZoneInfo zone;
+    ToNumber(section->title.Substr(title.GetSize()), zone.index);
+    GetNumber(*section, "Magic", zone.magic);
+    GetNumber(*section, "Size idx", zone.size_idx);
+    zones.push_back(zone);
+  }
+
+  if (zones.empty()) {
+    std::cerr << "Section " << title.ToString()
+              << " not found in pmempool info output" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_POOL_INFO_POOL_INFO_H_
+#define PMDK_TESTS_SRC_UTILS_POOL_INFO_POOL_INFO_H_
+
+#include <string>
+#include <vector>
+#include "api_c/file_view.h"
+#include "non_copyable/non_copyable.h"
+#include "string_view/string_view.h"
+
+/*
+ * InfoField -- "key : value" line of pmempool info output.
+ */
+struct InfoField {
+  StringView key;
+  StringView value;
+};
+
+/*
+ * InfoSection -- titled block of pmempool info output. Sections nested by
+ * indentation refer to their parent, fields of section are stored
+ * contiguously.
+ */
+struct InfoSection {
+  StringView title;
+  size_t indent;
+  size_t parent;
+  size_t first_field;
+  size_t field_count;
+};
+
+struct PoolHeaderInfo {
+  StringView signature;
+  unsigned long long major = 0;
+  StringView uuid;
+  bool checksum_ok = false;
+};
+
+struct ObjHeaderInfo {
+  StringView layout;
+  unsigned long long lanes_offset = 0;
+  unsigned long long nlanes = 0;
+  unsigned long long heap_offset = 0;
+  unsigned long long heap_size = 0;
+  unsigned long long root_offset = 0;
+};
+
+struct BlkHeaderInfo {
+  unsigned long long block_size = 0;
+  bool is_zeroed = false;
+};
+
+struct BttInfoHeader {
+  unsigned long long external_lba_size = 0;
+  unsigned long long external_lba_count = 0;
+  unsigned long long internal_lba_size = 0;
+  unsigned long long internal_lba_count = 0;
+  unsigned long long free_blocks = 0;
+  unsigned long long next_arena_offset = 0;
+};
+
+struct LogHeaderInfo {
+  unsigned long long start_offset = 0;
+  unsigned long long end_offset = 0;
+  unsigned long long write_offset = 0;
+};
+
+struct ZoneInfo {
+  unsigned long long index = 0;
+  unsigned long long magic = 0;
+  unsigned long long size_idx = 0;
+};
+
+/*
+ * PoolInfo -- parsed output of pmempool info, including --stats, --heap,
+ * --zones and --chunks sections. Output is indexed in a single pass and
+ * sections and fields refer to it without copying, so that outputs of
+ * hundreds of megabytes can be parsed from mapped file.
+ */
+class PoolInfo final : NonCopyable {
+ private:
+  FileView view_;
+  std::string content_;
+  StringView data_;
+  std::vector<InfoSection> sections_;
+  std::vector<InfoField> fields_;
+
+  void Index();
+  int GetSection(const StringView &title, const InfoSection *&section) const;
+
+ public:
+  static const size_t npos = static_cast<size_t>(-1);
+
+  /*
+   * Parse -- takes ownership of given pmempool info output and indexes it.
+   */
+  void Parse(std::string &&output);
+
+  /*
+   * ParseFile -- maps file holding pmempool info output and indexes it.
+   * Returns 0 on success, prints error message and returns -1 otherwise.
+   */
+  int ParseFile(const std::string &path);
+
+  const std::vector<InfoSection> &GetSections() const {
+    return sections_;
+  }
+  const std::vector<InfoField> &GetFields() const {
+    return fields_;
+  }
+
+  /*
+   * FindSection -- returns the first section following given one, with title
+   * starting with given prefix. Searches from the beginning if after is
+   * nullptr. Returns nullptr if there is no such section.
+   */
+  const InfoSection *FindSection(const StringView &prefix,
+                                 const InfoSection *after = nullptr) const;
+
+  /*
+   * GetValue -- returns value of field with given key in given section, empty
+   * view if there is no such field.
+   */
+  StringView GetValue(const InfoSection &section, const StringView &key) const;
+
+  /*
+   * GetNumber -- parses leading decimal or hexadecimal number of value of
+   * field with given key. Returns false if there is no such number.
+   */
+  bool GetNumber(const InfoSection &section, const StringView &key,
+                 unsigned long long &number) const;
+
+  /*
+   * Get*Header, GetBttInfoHeaders, GetZones -- fill typed structures with
+   * fields of corresponding sections. Return 0 on success, print error
+   * message and return -1 if section is missing.
+   */
+  int GetPoolHeader(PoolHeaderInfo &header) const;
+  int GetObjHeader(ObjHeaderInfo &header) const;
+  int GetBlkHeader(BlkHeaderInfo &header) const;
+  int GetLogHeader(LogHeaderInfo &header) const;
+  int GetBttInfoHeaders(std::vector<BttInfoHeader> &headers) const;
+  int GetZones(std::vector<ZoneInfo> &zones) const;
+
+  /*
+   * ToNumber -- parses leading decimal or hexadecimal (0x prefixed) number of
+   * given text. Returns false if text does not start with a number.
+   */
+  static bool ToNumber(const StringView &text, unsigned long long &number);
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_POOL_INFO_POOL_INFO_H_
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "part.h"
+#include <limits>
+
+int Part::ParseSize(StringView size, size_t &bytes) {
+  const size_t max = std::numeric_limits<size_t>::max();
+  size_t pos = 0;
+  bytes = 0;
+
+  while (pos < size.GetSize() && size[pos] >= '0' && size[pos] <= '9') {
+    size_t digit = static_cast<size_t>(size[pos] - '0');
+    if (bytes > (max - digit) / 10) {
+      bytes = 0;
+      return -1;
+    }
+    bytes = bytes * 10 + digit;
+    ++pos;
+  }
+
+  if (pos == 0) {
+    return -1;
+  }
+
+  StringView suffix = size.Substr(pos);
+  if (suffix.IsEmpty() || suffix == "B") {
+    return 0;
+  }
+
+  auto unit = SIZES.find(suffix.ToString());
+  if (unit == SIZES.end() || bytes > max / unit->second) {
+    bytes = 0;
+    return -1;
+  }
+
+  bytes *= unit->second;
+  return 0;
+}
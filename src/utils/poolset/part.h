@@ -34,6 +34,8 @@
 #define PMDK_TESTS_SRC_UTILS_POOLSET_PART_H_
 
 #include <string>
+#include "constants.h"
+#include "string_view/string_view.h"
 
 /*
  * Part -- class that represents part of replica specified in pool set file.
@@ -42,17 +44,44 @@ class Part final {
  private:
   std::string size_;
   std::string path_;
+  size_t byte_size_ = 0;
 
  public:
   Part(const std::string &size, const std::string &path)
       : size_(size), path_(path) {
+    ParseSize(size_, byte_size_);
+  }
+  Part(const std::string &size, const std::string &path, size_t byte_size)
+      : size_(size), path_(path), byte_size_(byte_size) {
   }
   const std::string &GetSize() const {
     return this->size_;
   };
+  /*
+   * GetByteSize -- returns part size in bytes, parsed once on construction. If
+   * size is invalid returns 0.
+   */
+  size_t GetByteSize() const {
+    return this->byte_size_;
+  }
   const std::string &GetPath() const {
     return this->path_;
   };
+  /*
+   * IsDirectory -- checks that part is a directory, which libpmemobj fills
+   * with files on demand, instead of a single file.
+   */
+  bool IsDirectory() const {
+    return path_.size() >= SEPARATOR.size() &&
+           path_.compare(path_.size() - SEPARATOR.size(), SEPARATOR.size(),
+                         SEPARATOR) == 0;
+  }
+
+  /*
+   * ParseSize -- converts part size (number with optional unit suffix) to
+   * bytes. Returns 0 on success, -1 otherwise and assigns 0 to bytes.
+   */
+  static int ParseSize(StringView size, size_t &bytes);
 };
 
 #endif  // !PMDK_TESTS_SRC_UTILS_POOLSET_PART_H_
@@ -42,6 +42,17 @@ std::vector<Part> Poolset::GetParts() const {
   return parts;
 }
 
+bool Poolset::IsGrowable() const {
+  for (const auto &replica : replicas_) {
+    for (const auto &part : replica.GetParts()) {
+      if (part.IsDirectory()) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 void Poolset::InitializeReplicas(std::initializer_list<replica> &&content) {
   for (const auto &replica : content) {
     this->replicas_.emplace_back(replica, path_, replica_counter_);
@@ -49,13 +60,47 @@ void Poolset::InitializeReplicas(std::initializer_list<replica> &&content) {
   }
 }
 
+void Poolset::InitializeReplicas(
+    const std::vector<std::vector<std::string>> &content) {
+  for (const auto &replica : content) {
+    this->replicas_.emplace_back(replica, path_, replica_counter_);
+    ++replica_counter_;
+  }
+}
+
 std::vector<std::string> Poolset::GetContent() const {
   std::vector<std::string> content;
   for (const auto &replica : replicas_) {
     content.emplace_back(replica.GetHeader());
+    if (&replica == &replicas_.front()) {
+      for (const auto &option : options_) {
+        content.emplace_back("OPTION " + option);
+      }
+    }
     for (const auto &part : replica.GetParts()) {
       content.emplace_back(part.GetSize() + " " + part.GetPath());
     }
   }
   return content;
 }
+
+Poolset Poolset::Rebase(const std::string &dir) const {
+  std::vector<Replica> replicas;
+  int count = 0;
+  for (const auto &replica : replicas_) {
+    std::vector<Part> parts;
+    for (const auto &part : replica.GetParts()) {
+      const std::string &path = part.GetPath();
+      if (path.compare(0, dir_.size(), dir_) == 0) {
+        parts.emplace_back(part.GetSize(), dir + path.substr(dir_.size()),
+                           part.GetByteSize());
+      } else {
+        parts.emplace_back(part);
+      }
+    }
+    replicas.emplace_back(replica.GetHeader(), std::move(parts), count++);
+  }
+
+  std::vector<std::string> options = options_;
+  return Poolset(dir, name_, std::move(replicas), std::move(options));
+}
@@ -49,7 +49,9 @@ class Poolset final {
   std::string name_ = "pool.set";
   std::string path_ = SEPARATOR + name_;
   std::vector<Replica> replicas_;
+  std::vector<std::string> options_;
   void InitializeReplicas(std::initializer_list<replica> &&content);
+  void InitializeReplicas(const std::vector<std::vector<std::string>> &content);
 
  public:
   Poolset() = default;
@@ -64,6 +66,30 @@ class Poolset final {
     path_ = dir_ + SEPARATOR + name_;
     InitializeReplicas(std::move(content));
   }
+  /*
+   * Poolset -- creates pool set from replicas generated at runtime. First line
+   * of each replica is its header, following lines describe its parts.
+   */
+  Poolset(const std::string &dir, const std::string &name,
+          const std::vector<std::vector<std::string>> &content)
+      : dir_(dir), name_(name) {
+    path_ = dir_ + SEPARATOR + name_;
+    InitializeReplicas(content);
+  }
+
+  /*
+   * Poolset -- creates pool set from already constructed replicas and pool set
+   * options (e.g. SINGLEHDR, NOHDRS).
+   */
+  Poolset(const std::string &dir, const std::string &name,
+          std::vector<Replica> &&replicas, std::vector<std::string> &&options)
+      : dir_(dir),
+        name_(name),
+        replicas_(std::move(replicas)),
+        options_(std::move(options)) {
+    path_ = dir_ + SEPARATOR + name_;
+    replica_counter_ = static_cast<int>(replicas_.size());
+  }
 
   const std::string &GetName() const {
     return this->name_;
@@ -81,11 +107,25 @@ class Poolset final {
   const std::vector<Replica> &GetReplicas() const {
     return this->replicas_;
   };
+  const std::vector<std::string> &GetOptions() const {
+    return this->options_;
+  }
+  /*
+   * IsGrowable -- checks that pool set contains directory parts, which
+   * libpmemobj extends on demand.
+   */
+  bool IsGrowable() const;
   /*
    * GetParts -- returns the vector of all parts specified in the pool set file.
    */
   std::vector<Part> GetParts() const;
   std::vector<std::string> GetContent() const;
+  /*
+   * Rebase -- returns copy of the pool set with pool set file and parts placed
+   * in dir instead of directory given on construction. Parts outside of that
+   * directory are left unchanged.
+   */
+  Poolset Rebase(const std::string &dir) const;
 };
 
 #endif  // !PMDK_TESTS_SRC_UTILS_POOLSET_POOLSET_H_
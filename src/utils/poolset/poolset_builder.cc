@@ -0,0 +1,85 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "poolset_builder.h"
+
+std::vector<size_t> PoolsetBuilder::GetPartSizes() const {
+  std::vector<size_t> sizes(pool_size_ / part_size_, part_size_);
+  size_t remainder = pool_size_ % part_size_;
+
+  /* too small remainder is merged into the last part */
+  if (remainder >= MIN_PART_SIZE || sizes.empty()) {
+    sizes.emplace_back(remainder);
+  } else {
+    sizes.back() += remainder;
+  }
+
+  return sizes;
+}
+
+int PoolsetBuilder::Build(const std::string &dir, Poolset &poolset) const {
+  if (part_size_ < MIN_PART_SIZE || pool_size_ < part_size_) {
+    std::cerr << "Part size has to be at least " << MIN_PART_SIZE
+              << " bytes and not greater than pool size" << std::endl;
+    return -1;
+  }
+
+  unsigned total_replicas = replica_count_ + 1;
+
+  if (mount_dirs_.size() < total_replicas) {
+    std::cerr << "Cannot place " << total_replicas << " replicas on "
+              << mount_dirs_.size() << " mount points" << std::endl;
+    return -1;
+  }
+
+  std::vector<size_t> part_sizes = GetPartSizes();
+  std::vector<std::vector<std::string>> content;
+
+  for (unsigned r = 0; r < total_replicas; ++r) {
+    std::vector<std::string> dirs;
+    for (size_t i = r; i < mount_dirs_.size(); i += total_replicas) {
+      dirs.emplace_back(mount_dirs_[i]);
+    }
+
+    std::vector<std::string> replica{r == 0 ? "PMEMPOOLSET" : "REPLICA"};
+    for (size_t p = 0; p < part_sizes.size(); ++p) {
+      const std::string &mount_dir = dirs[p % dirs.size()];
+      replica.emplace_back(std::to_string(part_sizes[p]) + " " + mount_dir +
+                           name_ + ".replica" + std::to_string(r) + ".part" +
+                           std::to_string(p));
+    }
+    content.emplace_back(std::move(replica));
+  }
+
+  poolset = Poolset(dir, name_ + ".set", content);
+  return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_POOLSET_POOLSET_BUILDER_H_
+#define PMDK_TESTS_SRC_UTILS_POOLSET_POOLSET_BUILDER_H_
+
+#include "poolset.h"
+
+/*
+ * PoolsetBuilder -- generates pool set of given size, striped over given mount
+ * points. Consecutive parts of each replica are interleaved across mount points
+ * assigned to the replica. Mount points are split between replicas, so that
+ * no replica shares a mount point with the master replica or other replicas.
+ */
+class PoolsetBuilder final {
+ private:
+  size_t pool_size_ = 0;
+  size_t part_size_ = 0;
+  unsigned replica_count_ = 0;
+  std::string name_ = "pool";
+  std::vector<std::string> mount_dirs_;
+
+  std::vector<size_t> GetPartSizes() const;
+
+ public:
+  /* minimal size of pool set part accepted by libpmemobj */
+  static const size_t MIN_PART_SIZE = 2 * MEBIBYTE;
+
+  PoolsetBuilder &SetPoolSize(size_t pool_size) {
+    pool_size_ = pool_size;
+    return *this;
+  }
+  PoolsetBuilder &SetPartSize(size_t part_size) {
+    part_size_ = part_size;
+    return *this;
+  }
+  /*
+   * SetReplicaCount -- sets number of replicas created in addition to the
+   * master replica.
+   */
+  PoolsetBuilder &SetReplicaCount(unsigned replica_count) {
+    replica_count_ = replica_count;
+    return *this;
+  }
+  /*
+   * SetName -- sets name of the pool set file and prefix of part file names.
+   */
+  PoolsetBuilder &SetName(const std::string &name) {
+    name_ = name;
+    return *this;
+  }
+  /*
+   * SetMountDirs -- sets directories on which parts are placed. Each directory
+   * path has to end with separator.
+   */
+  PoolsetBuilder &SetMountDirs(const std::vector<std::string> &mount_dirs) {
+    mount_dirs_ = mount_dirs;
+    return *this;
+  }
+
+  /*
+   * Build -- generates pool set with pool set file placed in dir. Returns 0 on
+   * success, prints error message and returns -1 otherwise.
+   */
+  int Build(const std::string &dir, Poolset &poolset) const;
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_POOLSET_POOLSET_BUILDER_H_
@@ -52,7 +52,7 @@ bool PoolsetManagement::NoFilesExist(const Poolset &p) {
 
 bool PoolsetManagement::ReplicaExists(const Replica &r) {
   for (const auto &part : r.GetParts()) {
-    if (!api_c_.RegularFileExists(part.GetPath())) {
+    if (!PartExists(part)) {
       return false;
     }
   }
@@ -60,6 +60,9 @@ bool PoolsetManagement::ReplicaExists(const Replica &r) {
 }
 
 bool PoolsetManagement::PartExists(const Part &p) {
+  if (p.IsDirectory()) {
+    return api_c_.DirectoryExists(p.GetPath());
+  }
   return api_c_.RegularFileExists(p.GetPath());
 }
 
@@ -68,7 +71,19 @@ bool PoolsetManagement::PoolsetFileExists(const Poolset &p) {
 }
 
 int PoolsetManagement::CreatePoolsetFile(const Poolset &p) {
-  return api_c_.CreateFileT(p.GetFullPath(), p.GetContent());
+  return api_c_.CreatePmemFileT(p.GetFullPath(), p.GetContent());
+}
+
+int PoolsetManagement::CreatePartDirectories(const Poolset &p) {
+  for (const auto &replica : p.GetReplicas()) {
+    for (const auto &part : replica.GetParts()) {
+      if (part.IsDirectory() && !api_c_.DirectoryExists(part.GetPath()) &&
+          api_c_.CreateDirectoryT(part.GetPath()) != 0) {
+        return -1;
+      }
+    }
+  }
+  return 0;
 }
 
 int PoolsetManagement::RemovePoolsetFile(const Poolset &p) {
@@ -78,11 +93,18 @@ int PoolsetManagement::RemovePoolsetFile(const Poolset &p) {
 int PoolsetManagement::RemovePartsFromPoolset(const Poolset &p) {
   int ret = 0;
   for (const auto &part : p.GetParts()) {
-    ret |= api_c_.RemoveFile(part.GetPath());
+    ret |= RemovePart(part);
   }
   return ret;
 }
 
 int PoolsetManagement::RemovePart(const Part &p) {
+  if (p.IsDirectory()) {
+    if (!api_c_.DirectoryExists(p.GetPath())) {
+      return -1;
+    }
+    return api_c_.CleanDirectory(p.GetPath()) |
+           api_c_.RemoveDirectoryT(p.GetPath());
+  }
   return api_c_.RemoveFile(p.GetPath());
 }
@@ -47,6 +47,12 @@ class PoolsetManagement final {
   bool PoolsetFileExists(const Poolset &p);
 
   int CreatePoolsetFile(const Poolset &p);
+  /*
+   * CreatePartDirectories -- creates directories of directory parts, which
+   * have to exist before the pool is created. Returns 0 on success, -1
+   * otherwise.
+   */
+  int CreatePartDirectories(const Poolset &p);
   int RemovePoolsetFile(const Poolset &p);
   int RemovePartsFromPoolset(const Poolset &p);
   int RemovePart(const Part &p);
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "poolset_parser.h"
+#include <iostream>
+#include "api_c/api_c.h"
+
+int PoolsetParser::Error(const std::string &msg) const {
+  std::cerr << path_ << ":" << line_number_ << ": " << msg << std::endl;
+  return -1;
+}
+
+int PoolsetParser::ParseOption(StringView line,
+                               std::vector<std::string> &options) const {
+  line.PopToken();
+  StringView option = line.PopToken();
+
+  if (option != "SINGLEHDR" && option != "NOHDRS") {
+    return Error("unknown option: " + option.ToString());
+  }
+
+  if (!line.IsEmpty()) {
+    return Error("unexpected tokens after option");
+  }
+
+  options.emplace_back(option.ToString());
+  return 0;
+}
+
+int PoolsetParser::Parse(const std::string &path, Poolset &poolset) {
+  FileView view;
+
+  if (ApiC::MapFile(path, view) != 0) {
+    return -1;
+  }
+
+  return ParseContent(
+      StringView(static_cast<const char *>(view.GetData()), view.GetSize()),
+      path, poolset);
+}
+
+int PoolsetParser::ParseContent(StringView content, const std::string &path,
+                                Poolset &poolset) {
+  path_ = path;
+  line_number_ = 0;
+
+  std::vector<Replica> replicas;
+  std::vector<std::string> options;
+  std::string header;
+  std::vector<Part> parts;
+  bool remote = false;
+
+  while (!content.IsEmpty()) {
+    StringView line = content.PopLine();
+    ++line_number_;
+
+    size_t comment = line.Find('#');
+    line = line.Substr(0, comment).Trim();
+
+    if (line.IsEmpty()) {
+      continue;
+    }
+
+    StringView rest = line;
+    StringView token = rest.PopToken();
+
+    if (header.empty()) {
+      if (token != "PMEMPOOLSET" || !rest.IsEmpty()) {
+        return Error("pool set file has to start with PMEMPOOLSET");
+      }
+      header = token.ToString();
+    } else if (token == "OPTION") {
+      if (!replicas.empty() || !parts.empty()) {
+        return Error("options have to precede parts of the master replica");
+      }
+      if (ParseOption(line, options) != 0) {
+        return -1;
+      }
+    } else if (token == "REPLICA") {
+      if (parts.empty() && !remote) {
+        return Error("replica without parts");
+      }
+      replicas.emplace_back(header, std::move(parts),
+                            static_cast<int>(replicas.size()));
+      parts.clear();
+
+      /* remote replica is described by node address and pool set name */
+      remote = !rest.IsEmpty();
+      if (remote) {
+        rest.PopToken();
+        if (rest.PopToken().IsEmpty() || !rest.IsEmpty()) {
+          return Error("remote replica requires node and pool set name");
+        }
+      }
+      header = line.ToString();
+    } else {
+      if (remote) {
+        return Error("remote replica cannot contain parts");
+      }
+
+      size_t bytes;
+      if (Part::ParseSize(token, bytes) != 0) {
+        return Error("invalid part size: " + token.ToString());
+      }
+
+      StringView part_path = rest.PopToken();
+      if (part_path.IsEmpty() || !rest.IsEmpty()) {
+        return Error("part has to be described by size and path");
+      }
+
+      parts.emplace_back(token.ToString(), part_path.ToString(), bytes);
+    }
+  }
+
+  if (header.empty()) {
+    return Error("pool set file is empty");
+  }
+
+  if (parts.empty() && !remote) {
+    return Error("replica without parts");
+  }
+
+  replicas.emplace_back(header, std::move(parts),
+                        static_cast<int>(replicas.size()));
+
+  size_t separator = path.rfind(SEPARATOR);
+  std::string dir =
+      separator == std::string::npos ? "." : path.substr(0, separator);
+  std::string name =
+      separator == std::string::npos ? path : path.substr(separator + 1);
+
+  poolset = Poolset(dir, name, std::move(replicas), std::move(options));
+  return 0;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_POOLSET_POOLSET_PARSER_H_
+#define PMDK_TESTS_SRC_UTILS_POOLSET_POOLSET_PARSER_H_
+
+#include "poolset.h"
+#include "string_view/string_view.h"
+
+/*
+ * PoolsetParser -- loads existing pool set files into Poolset. File is mapped
+ * and tokenized in a single pass without copying, only tokens stored in the
+ * resulting Poolset are copied.
+ */
+class PoolsetParser final {
+ private:
+  std::string path_;
+  unsigned line_number_ = 0;
+
+  int Error(const std::string &msg) const;
+  int ParseOption(StringView line, std::vector<std::string> &options) const;
+
+ public:
+  /*
+   * Parse -- reads pool set file in given path. Returns 0 on success, prints
+   * error message with the offending line number and returns -1 otherwise.
+   */
+  int Parse(const std::string &path, Poolset &poolset);
+
+  /*
+   * ParseContent -- parses pool set file content. Path is used to name the
+   * resulting pool set. Returns 0 on success, prints error message and returns
+   * -1 otherwise.
+   */
+  int ParseContent(StringView content, const std::string &path,
+                   Poolset &poolset);
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_POOLSET_POOLSET_PARSER_H_
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "poolset_validator.h"
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#include "api_c/api_c.h"
+
+void ValidationReport::Print(std::ostream &stream) const {
+  for (const auto &failure : failures_) {
+    stream << failure.part->GetPath() << ": ";
+    switch (failure.status) {
+      case PartStatus::Missing:
+        stream << "cannot access part: " << std::strerror(failure.error);
+        break;
+      case PartStatus::WrongType:
+        stream << (failure.part->IsDirectory() ? "directory" : "regular file")
+               << " expected";
+        break;
+      case PartStatus::SizeMismatch:
+        stream << "size mismatch, expected: " << failure.part->GetByteSize()
+               << " actual: " << failure.actual_size;
+        break;
+      case PartStatus::ModeMismatch:
+        stream << "permission mismatch, expected: " << expected_mode_
+               << " actual: " << failure.actual_mode;
+        break;
+      case PartStatus::Ok:
+        break;
+    }
+    stream << std::endl;
+  }
+}
+
+PoolsetValidator::PoolsetValidator(unsigned threads) : threads_(threads) {
+  if (threads_ == 0) {
+    threads_ = std::thread::hardware_concurrency();
+  }
+  if (threads_ == 0) {
+    threads_ = 1;
+  }
+}
+
+void PoolsetValidator::ValidatePart(const Part &part, int mode,
+                                    PartReport &report) {
+  FileStat file_stat;
+  report.part = &part;
+
+  if (ApiC::GetFileStat(part.GetPath(), file_stat) != 0) {
+    report.status = PartStatus::Missing;
+    report.error = errno;
+  } else if (part.IsDirectory() ? !file_stat.is_directory
+                                : !file_stat.is_regular) {
+    report.status = PartStatus::WrongType;
+  } else if (!part.IsDirectory() && part.GetByteSize() != file_stat.size) {
+    report.status = PartStatus::SizeMismatch;
+    report.actual_size = file_stat.size;
+  } else if (!part.IsDirectory() && file_stat.mode != mode) {
+    report.status = PartStatus::ModeMismatch;
+    report.actual_mode = file_stat.mode;
+  }
+}
+
+ValidationReport PoolsetValidator::Validate(const Poolset &poolset,
+                                            int mode) const {
+  std::vector<const Part *> parts;
+  for (const auto &replica : poolset.GetReplicas()) {
+    for (const auto &part : replica.GetParts()) {
+      parts.emplace_back(&part);
+    }
+  }
+
+  std::vector<PartReport> reports(parts.size());
+  size_t threads = parts.size() / PARTS_PER_THREAD;
+  threads = threads < threads_ ? threads : threads_;
+
+  auto worker = [&](size_t thread, size_t count) {
+    size_t begin = parts.size() * thread / count;
+    size_t end = parts.size() * (thread + 1) / count;
+    for (size_t i = begin; i < end; ++i) {
+      ValidatePart(*parts[i], mode, reports[i]);
+    }
+  };
+
+  if (threads <= 1) {
+    worker(0, 1);
+  } else {
+    std::vector<std::thread> pool;
+    for (size_t i = 0; i < threads; ++i) {
+      pool.emplace_back(worker, i, threads);
+    }
+    for (auto &thread : pool) {
+      thread.join();
+    }
+  }
+
+  ValidationReport report;
+  report.checked_ = parts.size();
+  report.expected_mode_ = mode;
+  for (const auto &part_report : reports) {
+    if (part_report.status != PartStatus::Ok) {
+      report.failures_.emplace_back(part_report);
+    }
+  }
+
+  return report;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_POOLSET_POOLSET_VALIDATOR_H_
+#define PMDK_TESTS_SRC_UTILS_POOLSET_POOLSET_VALIDATOR_H_
+
+#include <ostream>
+#include "poolset.h"
+
+enum class PartStatus { Ok, Missing, WrongType, SizeMismatch, ModeMismatch };
+
+/*
+ * PartReport -- result of validation of single part.
+ */
+struct PartReport {
+  const Part *part = nullptr;
+  PartStatus status = PartStatus::Ok;
+  unsigned long long actual_size = 0;
+  unsigned short actual_mode = 0;
+  int error = 0;
+};
+
+/*
+ * ValidationReport -- result of pool set validation. Holds reports of parts
+ * which failed validation. Parts refer to the validated pool set, which has to
+ * outlive the report.
+ */
+class ValidationReport final {
+ private:
+  size_t checked_ = 0;
+  int expected_mode_ = 0;
+  std::vector<PartReport> failures_;
+
+  friend class PoolsetValidator;
+
+ public:
+  bool IsValid() const {
+    return failures_.empty();
+  }
+  size_t GetCheckedCount() const {
+    return checked_;
+  }
+  const std::vector<PartReport> &GetFailures() const {
+    return failures_;
+  }
+  void Print(std::ostream &stream) const;
+};
+
+/*
+ * PoolsetValidator -- validates existence, type, size and mode of all parts of
+ * pool set in a single pass. Each part is checked with one stat call and parts
+ * are distributed among threads. Directory parts are only checked to be
+ * directories, as their size and mode differ from the pool files inside.
+ */
+class PoolsetValidator final {
+ private:
+  unsigned threads_;
+
+  static void ValidatePart(const Part &part, int mode, PartReport &report);
+
+ public:
+  /* parts validated by single thread, below which no thread is spawned */
+  static const size_t PARTS_PER_THREAD = 64;
+
+  explicit PoolsetValidator(unsigned threads = 0);
+
+  ValidationReport Validate(const Poolset &poolset, int mode) const;
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_POOLSET_POOLSET_VALIDATOR_H_
@@ -31,39 +31,45 @@
  */
 
 #include "replica.h"
-#include <sstream>
+#include "string_view/string_view.h"
 
 Replica::Replica(std::vector<std::string> content, const std::string &path,
                  int count)
     : count_(count) {
   this->header_ = content.front();
   content.erase(content.begin());
+  ParseHeader();
 
-  const int ONLY_SIZE_GIVEN = 1;
   part_count_ = 0;
 
   for (const std::string &line : content) {
-    std::vector<std::string> vec = Split(line);
-
-    std::string part_size = vec[0];
+    StringView rest(line);
+    std::string part_size = rest.PopToken().ToString();
     std::string part_path =
-        vec.size() == ONLY_SIZE_GIVEN ? path + CreatePartName() : vec[1];
+        rest.IsEmpty() ? path + CreatePartName() : rest.PopToken().ToString();
 
     this->parts_.emplace_back(part_size, part_path);
     ++part_count_;
   }
 }
 
-std::vector<std::string> Replica::Split(const std::string &str) const {
-  const char DELIMITER = ' ';
-  std::vector<std::string> vec;
+Replica::Replica(const std::string &header, std::vector<Part> &&parts,
+                 int count)
+    : header_(header),
+      parts_(std::move(parts)),
+      count_(count),
+      part_count_(static_cast<int>(parts_.size())) {
+  ParseHeader();
+}
+
+void Replica::ParseHeader() {
+  StringView rest(header_);
+  rest.PopToken();
 
-  std::istringstream stream(str);
-  std::string token;
-  while (std::getline(stream, token, DELIMITER)) {
-    vec.push_back(token);
+  if (!rest.IsEmpty()) {
+    remote_node_ = rest.PopToken().ToString();
+    remote_poolset_ = rest.PopToken().ToString();
   }
-  return vec;
 }
 
 std::string Replica::CreatePartName() const {
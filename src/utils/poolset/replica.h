@@ -42,6 +42,8 @@
 class Replica final {
  private:
   std::string header_;
+  std::string remote_node_;
+  std::string remote_poolset_;
   std::vector<Part> parts_;
   int count_;
   int part_count_;
@@ -50,13 +52,27 @@ class Replica final {
   bool IsMasterReplica() const {
     return this->header_.compare("PMEMPOOLSET") == 0;
   };
-  std::vector<std::string> Split(const std::string &str) const;
+  void ParseHeader();
 
  public:
   Replica(std::vector<std::string> content, const std::string &path, int count);
+  Replica(const std::string &header, std::vector<Part> &&parts, int count);
   const std::string &GetHeader() const {
     return this->header_;
   };
+  /*
+   * IsRemote -- checks that replica is placed on remote node. Remote replica
+   * header consists of node address and name of pool set file on the node.
+   */
+  bool IsRemote() const {
+    return !this->remote_node_.empty();
+  }
+  const std::string &GetRemoteNode() const {
+    return this->remote_node_;
+  }
+  const std::string &GetRemotePoolset() const {
+    return this->remote_poolset_;
+  }
   const std::vector<Part> &GetParts() const {
     return this->parts_;
   };
@@ -0,0 +1,278 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "recovery_orchestrator.h"
+#include <libpmempool.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include "api_c/api_c.h"
+#include "poolset/poolset_parser.h"
+
+namespace {
+const std::string POOLSET_SIGNATURE = "PMEMPOOLSET";
+
+/*
+ * DeviceQueue -- pools waiting for recovery on a single device.
+ */
+struct DeviceQueue {
+  unsigned long long device;
+  std::deque<size_t> pending;
+  unsigned active = 0;
+};
+}  // namespace
+
+RecoveryOrchestrator::RecoveryOrchestrator(unsigned max_workers,
+                                           unsigned workers_per_device)
+    : max_workers_(max_workers), workers_per_device_(workers_per_device) {
+  if (max_workers_ == 0) {
+    max_workers_ = std::thread::hardware_concurrency();
+  }
+  if (max_workers_ == 0) {
+    max_workers_ = 1;
+  }
+  if (workers_per_device_ == 0) {
+    workers_per_device_ = 1;
+  }
+}
+
+bool RecoveryOrchestrator::IsPoolset(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  std::string signature(POOLSET_SIGNATURE.size(), '\0');
+
+  return file.read(&signature[0], signature.size()) &&
+         signature == POOLSET_SIGNATURE;
+}
+
+int RecoveryOrchestrator::GetDevice(const std::string &path,
+                                    unsigned long long &device,
+                                    unsigned &replicas) {
+  std::string data_path = path;
+  replicas = 1;
+
+  if (IsPoolset(path)) {
+    Poolset poolset;
+    if (PoolsetParser().Parse(path, poolset) != 0 ||
+        poolset.GetReplicas().empty() ||
+        poolset.GetReplica(0).GetParts().empty()) {
+      return -1;
+    }
+    replicas = static_cast<unsigned>(poolset.GetReplicas().size());
+    data_path = poolset.GetReplica(0).GetPart(0).GetPath();
+  }
+
+  FileStat file_stat;
+  if (ApiC::GetFileStat(data_path, file_stat) != 0) {
+    return -1;
+  }
+
+  device = file_stat.device;
+  return 0;
+}
+
+bool RecoveryOrchestrator::Check(const std::string &path, bool repair,
+                                 std::string &message) {
+  unsigned flags = PMEMPOOL_CHECK_FORMAT_STR;
+  if (repair) {
+    flags |= PMEMPOOL_CHECK_REPAIR | PMEMPOOL_CHECK_ALWAYS_YES;
+  }
+  struct pmempool_check_args args = {path.c_str(), nullptr,
+                                     PMEMPOOL_POOL_TYPE_DETECT, flags};
+
+  PMEMpoolcheck *ppc = pmempool_check_init(&args, sizeof(args));
+  if (ppc == nullptr) {
+    message = pmempool_errormsg();
+    return false;
+  }
+
+  pmempool_check_status *status;
+  while ((status = pmempool_check(ppc)) != nullptr) {
+    if (status->type == PMEMPOOL_CHECK_MSG_TYPE_ERROR) {
+      message = status->str.msg;
+    }
+  }
+
+  enum pmempool_check_result result = pmempool_check_end(ppc);
+  switch (result) {
+    case PMEMPOOL_CHECK_RESULT_CONSISTENT:
+      return true;
+    case PMEMPOOL_CHECK_RESULT_REPAIRED:
+      message = "repaired";
+      return true;
+    default:
+      if (message.empty()) {
+        message = "check result " + std::to_string(result);
+      }
+      return false;
+  }
+}
+
+bool RecoveryOrchestrator::Sync(const std::string &path,
+                                std::string &message) {
+  if (pmempool_sync(path.c_str(), 0) != 0) {
+    message = pmempool_errormsg();
+    return false;
+  }
+
+  return true;
+}
+
+void RecoveryOrchestrator::RunAction(RecoveryResult &result,
+                                     RecoveryAction action,
+                                     unsigned replicas) {
+  auto start = std::chrono::steady_clock::now();
+
+  switch (action) {
+    case RecoveryAction::Check:
+      result.success = Check(result.path, false, result.message);
+      break;
+    case RecoveryAction::Repair:
+      result.success = Check(result.path, true, result.message) &&
+                       (replicas < 2 || Sync(result.path, result.message));
+      break;
+    case RecoveryAction::Sync:
+      result.success = Sync(result.path, result.message);
+      break;
+  }
+
+  result.seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+}
+
+RecoveryResult RecoveryOrchestrator::Recover(const std::string &path,
+                                             RecoveryAction action) {
+  RecoveryResult result;
+  unsigned replicas;
+
+  result.path = path;
+  if (GetDevice(path, result.device, replicas) != 0) {
+    result.message = "cannot access pool";
+    return result;
+  }
+
+  RunAction(result, action, replicas);
+  return result;
+}
+
+int RecoveryOrchestrator::Run(const std::vector<std::string> &paths,
+                              RecoveryAction action,
+                              std::vector<RecoveryResult> &results) const {
+  std::vector<unsigned> replicas(paths.size());
+  std::vector<DeviceQueue> queues;
+  std::mutex mutex;
+  std::condition_variable finished;
+  size_t completed = 0, pending = 0;
+
+  results.assign(paths.size(), RecoveryResult());
+  for (size_t i = 0; i < paths.size(); ++i) {
+    RecoveryResult &result = results[i];
+    result.path = paths[i];
+
+    if (GetDevice(paths[i], result.device, replicas[i]) != 0) {
+      result.message = "cannot access pool";
+      if (progress_) {
+        progress_(result, ++completed, paths.size());
+      }
+      continue;
+    }
+
+    auto queue = queues.begin();
+    while (queue != queues.end() && queue->device != result.device) {
+      ++queue;
+    }
+    if (queue == queues.end()) {
+      queues.emplace_back();
+      queue = queues.end() - 1;
+      queue->device = result.device;
+    }
+    queue->pending.emplace_back(i);
+    ++pending;
+  }
+
+  auto worker = [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (pending > 0) {
+      /* the longest queue with a free slot goes first */
+      DeviceQueue *queue = nullptr;
+      for (auto &q : queues) {
+        if (!q.pending.empty() && q.active < workers_per_device_ &&
+            (queue == nullptr || q.pending.size() > queue->pending.size())) {
+          queue = &q;
+        }
+      }
+
+      if (queue == nullptr) {
+        finished.wait(lock);
+        continue;
+      }
+
+      size_t index = queue->pending.front();
+      queue->pending.pop_front();
+      --pending;
+      ++queue->active;
+
+      lock.unlock();
+      RunAction(results[index], action, replicas[index]);
+      lock.lock();
+
+      --queue->active;
+      if (progress_) {
+        progress_(results[index], ++completed, paths.size());
+      }
+      finished.notify_all();
+    }
+  };
+
+  size_t workers = std::min<size_t>(
+      {max_workers_, pending, queues.size() * workers_per_device_});
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < workers; ++i) {
+    threads.emplace_back(worker);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (const auto &result : results) {
+    if (!result.success) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
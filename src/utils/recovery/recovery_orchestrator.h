@@ -0,0 +1,115 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_RECOVERY_RECOVERY_ORCHESTRATOR_H_
+#define PMDK_TESTS_SRC_UTILS_RECOVERY_RECOVERY_ORCHESTRATOR_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "non_copyable/non_copyable.h"
+
+/*
+ * RecoveryAction -- operation run on each pool. Repair of pool set with
+ * replicas is followed by synchronization of the replicas.
+ */
+enum class RecoveryAction { Check, Repair, Sync };
+
+/*
+ * RecoveryResult -- outcome of recovery of single pool or pool set.
+ */
+struct RecoveryResult {
+  std::string path;
+  unsigned long long device = 0;
+  bool success = false;
+  std::string message;
+  double seconds = 0;
+};
+
+/*
+ * RecoveryOrchestrator -- runs check, repair or sync of many pools with
+ * bounded number of workers. Pools are queued by device holding their files
+ * (the first part for pool sets), so that each device is recovered by at most
+ * workers_per_device workers at a time and all devices progress in parallel.
+ */
+class RecoveryOrchestrator final : NonCopyable {
+ public:
+  using ProgressCallback = std::function<void(
+      const RecoveryResult &result, size_t completed, size_t total)>;
+
+ private:
+  unsigned max_workers_;
+  unsigned workers_per_device_;
+  ProgressCallback progress_;
+
+  static int GetDevice(const std::string &path, unsigned long long &device,
+                       unsigned &replicas);
+  static bool IsPoolset(const std::string &path);
+  static bool Check(const std::string &path, bool repair,
+                    std::string &message);
+  static bool Sync(const std::string &path, std::string &message);
+  static void RunAction(RecoveryResult &result, RecoveryAction action,
+                        unsigned replicas);
+
+ public:
+  /*
+   * RecoveryOrchestrator -- max_workers equal to 0 stands for number of
+   * hardware threads.
+   */
+  explicit RecoveryOrchestrator(unsigned max_workers = 0,
+                                unsigned workers_per_device = 1);
+
+  /*
+   * SetProgressCallback -- sets function called after each pool is recovered.
+   * Calls are serialized.
+   */
+  void SetProgressCallback(const ProgressCallback &progress) {
+    progress_ = progress;
+  }
+
+  /*
+   * Recover -- runs given action on a single pool or pool set on the calling
+   * thread. Returns result of the action.
+   */
+  static RecoveryResult Recover(const std::string &path,
+                                RecoveryAction action);
+
+  /*
+   * Run -- runs given action on all pools and pool sets in paths. Results are
+   * stored in the order of paths. Returns 0 if all pools were recovered, -1
+   * otherwise.
+   */
+  int Run(const std::vector<std::string> &paths, RecoveryAction action,
+          std::vector<RecoveryResult> &results) const;
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_RECOVERY_RECOVERY_ORCHESTRATOR_H_
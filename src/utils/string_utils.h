@@ -33,7 +33,9 @@
 #ifndef PMDK_TESTS_SRC_UTILS_STRING_UTILS_H_
 #define PMDK_TESTS_SRC_UTILS_STRING_UTILS_H_
 
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -52,20 +54,21 @@ std::basic_string<To> Convert(std::basic_string<From> f) {
  * as a delimiter.
  */
 template <typename T, template <typename...> class container = std::vector>
-container<std::basic_string<T>> Tokenize(std::basic_string<T> str) {
+container<std::basic_string<T>> Tokenize(const std::basic_string<T> &str) {
+  size_t begin = 0;
   size_t pos;
   container<std::basic_string<T>> cont;
 
   std::basic_string<T> separator = string_utils::Convert<T, char>("\n");
 
-  while ((pos = str.find_first_of(separator, 0)) !=
+  while ((pos = str.find_first_of(separator, begin)) !=
          std::basic_string<T>::npos) {
-    cont.emplace_back(str.substr(0, pos));
-    str.erase(0, pos + 1);
+    cont.emplace_back(str.substr(begin, pos - begin));
+    begin = pos + 1;
   }
 
-  if (!str.empty()) {
-    cont.emplace_back(str);
+  if (begin < str.size()) {
+    cont.emplace_back(str.substr(begin));
   }
 
   return cont;
@@ -87,6 +90,40 @@ void ReplaceAll(std::basic_string<T> &string,
     pos = string.find(before, pos + before.size());
   }
 }
+
+/*
+ * EscapeJson -- escapes characters of given string, so that it can be placed
+ * between quotes of JSON string.
+ */
+inline std::string EscapeJson(const std::string &value) {
+  std::ostringstream escaped;
+
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        escaped << "\\\"";
+        break;
+      case '\\':
+        escaped << "\\\\";
+        break;
+      case '\n':
+        escaped << "\\n";
+        break;
+      case '\t':
+        escaped << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                  << static_cast<int>(c) << std::dec;
+        } else {
+          escaped << c;
+        }
+    }
+  }
+
+  return escaped.str();
+}
 }  // namespace string_utils
 
 #endif  // !PMDK_TESTS_SRC_UTILS_STRING_UTILS_H_
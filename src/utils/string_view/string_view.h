@@ -0,0 +1,173 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_STRING_VIEW_STRING_VIEW_H_
+#define PMDK_TESTS_SRC_UTILS_STRING_VIEW_STRING_VIEW_H_
+
+#include <cstring>
+#include <string>
+
+/*
+ * StringView -- non-owning, read-only reference to a sequence of characters.
+ * Referenced memory has to outlive the view.
+ */
+class StringView final {
+ private:
+  const char *data_ = nullptr;
+  size_t size_ = 0;
+
+ public:
+  static const size_t npos = static_cast<size_t>(-1);
+
+  StringView() = default;
+  StringView(const char *data, size_t size) : data_(data), size_(size) {
+  }
+  StringView(const char *str) : data_(str), size_(std::strlen(str)) {
+  }
+  StringView(const std::string &str) : data_(str.data()), size_(str.size()) {
+  }
+
+  const char *GetData() const {
+    return data_;
+  }
+  size_t GetSize() const {
+    return size_;
+  }
+  bool IsEmpty() const {
+    return size_ == 0;
+  }
+  const char *begin() const {
+    return data_;
+  }
+  const char *end() const {
+    return data_ + size_;
+  }
+  char operator[](size_t pos) const {
+    return data_[pos];
+  }
+  char Back() const {
+    return data_[size_ - 1];
+  }
+
+  /*
+   * Substr -- returns view of at most count characters starting at pos.
+   */
+  StringView Substr(size_t pos, size_t count = npos) const {
+    if (pos > size_) {
+      pos = size_;
+    }
+    return StringView(data_ + pos, count < size_ - pos ? count : size_ - pos);
+  }
+
+  /*
+   * Find -- returns position of the first occurrence of c at or after pos,
+   * npos if there is none.
+   */
+  size_t Find(char c, size_t pos = 0) const {
+    if (pos >= size_) {
+      return npos;
+    }
+    const void *found = std::memchr(data_ + pos, c, size_ - pos);
+    return found == nullptr ? npos : static_cast<const char *>(found) - data_;
+  }
+
+  bool StartsWith(StringView prefix) const {
+    return prefix.size_ == 0 ||
+           (prefix.size_ <= size_ &&
+            std::memcmp(data_, prefix.data_, prefix.size_) == 0);
+  }
+
+  /*
+   * Trim -- returns view without leading and trailing whitespace.
+   */
+  StringView Trim() const {
+    size_t begin = 0;
+    size_t end = size_;
+    while (begin < end && IsSpace(data_[begin])) {
+      ++begin;
+    }
+    while (end > begin && IsSpace(data_[end - 1])) {
+      --end;
+    }
+    return StringView(data_ + begin, end - begin);
+  }
+
+  /*
+   * PopToken -- returns the first whitespace delimited token and removes it
+   * from the view along with surrounding whitespace.
+   */
+  StringView PopToken() {
+    *this = Trim();
+    size_t end = 0;
+    while (end < size_ && !IsSpace(data_[end])) {
+      ++end;
+    }
+    StringView token(data_, end);
+    *this = Substr(end).Trim();
+    return token;
+  }
+
+  /*
+   * PopLine -- returns the first line without line terminator and removes it
+   * from the view.
+   */
+  StringView PopLine() {
+    size_t end = Find('\n');
+    StringView line = Substr(0, end);
+    *this = end == npos ? StringView(data_ + size_, 0) : Substr(end + 1);
+    if (!line.IsEmpty() && line.Back() == '\r') {
+      line.size_--;
+    }
+    return line;
+  }
+
+  std::string ToString() const {
+    return std::string(data_, size_);
+  }
+
+  static bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' ||
+           c == '\f';
+  }
+};
+
+inline bool operator==(StringView lhs, StringView rhs) {
+  return lhs.GetSize() == rhs.GetSize() &&
+         (lhs.IsEmpty() ||
+          std::memcmp(lhs.GetData(), rhs.GetData(), lhs.GetSize()) == 0);
+}
+
+inline bool operator!=(StringView lhs, StringView rhs) {
+  return !(lhs == rhs);
+}
+
+#endif  // !PMDK_TESTS_SRC_UTILS_STRING_VIEW_STRING_VIEW_H_
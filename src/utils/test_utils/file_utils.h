@@ -38,64 +38,23 @@
 #include "constants.h"
 #include "poolset/poolset.h"
 #include "poolset/poolset_management.h"
+#include "poolset/poolset_validator.h"
 
 namespace file_utils {
-static inline size_t GetSize(std::string size) {
-  std::array<std::string, 9> suffix = {"KiB", "MiB", "GiB", "KB", "MB",
-                                       "GB",  "K",   "M",   "G"};
-  size_t pos;
-  for (const auto &suf : suffix) {
-    if ((pos = size.find(suf)) != std::string::npos) {
-      size.erase(pos);
-
-      return static_cast<size_t>(std::stoul(size)) * SIZES.at(suf);
-    }
-  }
-
-  return static_cast<size_t>(std::stoul(size));
-}
-
 /*
  * ValidatePoolset -- checks that all parts in poolset exist, sizes of parts are
  * correct and specified mode is set. Returns 0 on success, print error message
  * and returns -1 otherwise.
  */
 static inline int ValidatePoolset(const Poolset &poolset, int poolset_mode) {
-  PoolsetManagement p_mgmt;
-
-  if (!p_mgmt.AllFilesExist(poolset)) {
-    std::cerr << "Part's from the pool set file are missing" << std::endl;
-    return -1;
-  }
+  ValidationReport report = PoolsetValidator().Validate(poolset, poolset_mode);
 
-  int ret = 0;
-  size_t size = 0;
-  for (const auto &part : poolset.GetParts()) {
-    size = ApiC::GetFileSize(part.GetPath());
-    if (GetSize(part.GetSize()) != size) {
-      std::cerr << "Part's size mismatch\n"
-                << part.GetPath() << "\nExpected: " << part.GetSize()
-                << "\nActual: " << size << std::endl;
-      ret = -1;
-    }
-  }
-
-  if (ret == -1) {
+  if (!report.IsValid()) {
+    report.Print(std::cerr);
     return -1;
   }
 
-  int mode = 0;
-  for (const auto &part : poolset.GetParts()) {
-    mode = ApiC::GetFilePermission(part.GetPath());
-    if (poolset_mode != mode) {
-      std::cerr << "Part's permission mismatch\n"
-                << part.GetPath() << "\nExpected: " << poolset_mode
-                << "\nActual: " << mode << std::endl;
-      ret = -1;
-    }
-  }
-
-  return ret;
+  return 0;
 }
 
 /*
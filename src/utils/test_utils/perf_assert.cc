@@ -0,0 +1,202 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "perf_assert.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include "histogram/histogram.h"
+#include "timer/timer.h"
+
+namespace perf_assert {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/* 0.975 quantiles of Student's t distribution for 1-30 degrees of freedom */
+const double T_QUANTILES[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447,
+                              2.365,  2.306, 2.262, 2.228, 2.201, 2.179,
+                              2.160,  2.145, 2.131, 2.120, 2.110, 2.101,
+                              2.093,  2.086, 2.080, 2.074, 2.069, 2.064,
+                              2.060,  2.056, 2.052, 2.048, 2.045, 2.042};
+
+double GetTQuantile(size_t degrees) {
+  const size_t count = sizeof(T_QUANTILES) / sizeof(T_QUANTILES[0]);
+  return degrees <= count ? T_QUANTILES[degrees - 1] : 1.96;
+}
+
+std::string Describe(const std::string &name, const PerfStats &stats,
+                     const std::string &unit) {
+  std::ostringstream description;
+  description << name << ": " << stats.mean << " " << unit << " (95% CI ["
+              << stats.ci_low << ", " << stats.ci_high << "], "
+              << stats.samples.size() << " trials)";
+  return description.str();
+}
+
+void Report(const std::string &name, const PerfStats &stats,
+            const std::string &unit) {
+  std::cout << "[   PERF   ] " << Describe(name, stats, unit) << std::endl;
+  ::testing::Test::RecordProperty(name, std::to_string(stats.mean));
+}
+}  // namespace
+
+PerfStats ComputeStats(std::vector<double> samples) {
+  PerfStats stats;
+  stats.samples = std::move(samples);
+  size_t n = stats.samples.size();
+
+  if (n == 0) {
+    return stats;
+  }
+
+  double sum = 0;
+  for (double sample : stats.samples) {
+    sum += sample;
+  }
+  stats.mean = sum / n;
+
+  if (n == 1) {
+    stats.ci_low = stats.ci_high = stats.mean;
+    return stats;
+  }
+
+  double squares = 0;
+  for (double sample : stats.samples) {
+    squares += (sample - stats.mean) * (sample - stats.mean);
+  }
+  stats.stddev = std::sqrt(squares / (n - 1));
+
+  double half_width = GetTQuantile(n - 1) * stats.stddev / std::sqrt(n);
+  stats.ci_low = stats.mean - half_width;
+  stats.ci_high = stats.mean + half_width;
+
+  return stats;
+}
+
+PerfStats MeasureThroughput(const std::function<void()> &op,
+                            const PerfOptions &options) {
+  std::vector<double> samples;
+
+  for (unsigned trial = 0; trial < options.warmup_trials + options.trials;
+       ++trial) {
+    Clock::time_point start = Clock::now();
+    for (unsigned i = 0; i < options.ops_per_trial; ++i) {
+      op();
+    }
+    double seconds =
+        std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (trial >= options.warmup_trials && seconds > 0) {
+      samples.emplace_back(options.ops_per_trial / seconds / 1e6);
+    }
+  }
+
+  return ComputeStats(std::move(samples));
+}
+
+PerfStats MeasureLatencyP99(const std::function<void()> &op,
+                            const PerfOptions &options) {
+  std::vector<double> samples;
+  Histogram latencies;
+
+  for (unsigned trial = 0; trial < options.warmup_trials + options.trials;
+       ++trial) {
+    latencies.Reset();
+    for (unsigned i = 0; i < options.ops_per_trial; ++i) {
+      uint64_t start = Timer::ReadTicks();
+      op();
+      latencies.Record(Timer::GetElapsedNanoseconds(start));
+    }
+
+    if (trial >= options.warmup_trials && latencies.GetCount() != 0) {
+      samples.emplace_back(latencies.GetPercentile(99) / 1e3);
+    }
+  }
+
+  return ComputeStats(std::move(samples));
+}
+
+::testing::AssertionResult CheckThroughput(const PerfThresholds &thresholds,
+                                           const std::string &name,
+                                           const PerfStats &stats) {
+  Report(name, stats, "Mops/s");
+
+  double threshold;
+  if (!thresholds.Get(name, threshold)) {
+    return ::testing::AssertionSuccess();
+  }
+
+  double limit = threshold * (1 - thresholds.GetTolerance());
+  if (stats.samples.empty() || stats.ci_high < limit) {
+    return ::testing::AssertionFailure()
+           << Describe(name, stats, "Mops/s") << " is below threshold "
+           << threshold << " Mops/s with tolerance "
+           << thresholds.GetTolerance() * 100 << "%";
+  }
+
+  return ::testing::AssertionSuccess();
+}
+
+::testing::AssertionResult CheckLatencyP99(const PerfThresholds &thresholds,
+                                           const std::string &name,
+                                           const PerfStats &stats) {
+  Report(name, stats, "us");
+
+  double threshold;
+  if (!thresholds.Get(name, threshold)) {
+    return ::testing::AssertionSuccess();
+  }
+
+  double limit = threshold * (1 + thresholds.GetTolerance());
+  if (stats.samples.empty() || stats.ci_low > limit) {
+    return ::testing::AssertionFailure()
+           << Describe(name, stats, "us") << " exceeds threshold "
+           << threshold << " us with tolerance "
+           << thresholds.GetTolerance() * 100 << "%";
+  }
+
+  return ::testing::AssertionSuccess();
+}
+
+void ExcludePerfTests() {
+  const std::string perf_filter = "PERF_*:*.PERF_*";
+  std::string &filter = ::testing::GTEST_FLAG(filter);
+  size_t dash = filter.find('-');
+
+  if (filter.substr(0, dash).find("PERF_") != std::string::npos) {
+    return;
+  }
+
+  filter += (dash == std::string::npos ? "-" : ":") + perf_filter;
+}
+}  // namespace perf_assert
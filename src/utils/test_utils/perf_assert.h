@@ -0,0 +1,128 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_TEST_UTILS_PERF_ASSERT_H_
+#define PMDK_TESTS_SRC_UTILS_TEST_UTILS_PERF_ASSERT_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "perf_thresholds.h"
+
+namespace perf_assert {
+struct PerfOptions {
+  /* trials run before measurement, not taken into account */
+  unsigned warmup_trials = 1;
+  unsigned trials = 10;
+  unsigned ops_per_trial = 10000;
+};
+
+/*
+ * PerfStats -- per-trial samples of measured value with their mean, standard
+ * deviation and 95% confidence interval of the mean (Student's t).
+ */
+struct PerfStats {
+  std::vector<double> samples;
+  double mean = 0;
+  double stddev = 0;
+  double ci_low = 0;
+  double ci_high = 0;
+};
+
+/*
+ * ComputeStats -- computes mean, standard deviation and 95% confidence
+ * interval of the mean of given samples.
+ */
+PerfStats ComputeStats(std::vector<double> samples);
+
+/*
+ * MeasureThroughput -- runs op ops_per_trial times in every trial, after
+ * warmup trials. Sample of the trial is its throughput in Mops/s.
+ */
+PerfStats MeasureThroughput(const std::function<void()> &op,
+                            const PerfOptions &options = PerfOptions());
+
+/*
+ * MeasureLatencyP99 -- times every of ops_per_trial calls of op in every
+ * trial, after warmup trials. Sample of the trial is 99th percentile of its
+ * latencies in microseconds.
+ */
+PerfStats MeasureLatencyP99(const std::function<void()> &op,
+                            const PerfOptions &options = PerfOptions());
+
+/*
+ * CheckThroughput -- checks throughput against minimal throughput of given
+ * name. Gate fails only if the whole confidence interval is below threshold
+ * lowered by tolerance, so that noise of single trials does not fail the
+ * test. Without threshold only reports the result.
+ */
+::testing::AssertionResult CheckThroughput(const PerfThresholds &thresholds,
+                                           const std::string &name,
+                                           const PerfStats &stats);
+
+/*
+ * CheckLatencyP99 -- checks 99th percentile latency against maximal latency of
+ * given name. Gate fails only if the whole confidence interval is above
+ * threshold raised by tolerance. Without threshold only reports the result.
+ */
+::testing::AssertionResult CheckLatencyP99(const PerfThresholds &thresholds,
+                                           const std::string &name,
+                                           const PerfStats &stats);
+
+/*
+ * ExcludePerfTests -- excludes performance tests, i.e. test cases and tests
+ * named with PERF_ prefix, from gtest filter unless its positive part selects
+ * them explicitly (e.g. --gtest_filter=*PERF_*), so that measurements do not
+ * slow down regular runs. Has to be called after ::testing::InitGoogleTest.
+ */
+void ExcludePerfTests();
+}  // namespace perf_assert
+
+/*
+ * EXPECT_THROUGHPUT_GE -- measures throughput of op (Mops/s) and expects it
+ * not to be lower than threshold of given name from thresholds.
+ */
+#define EXPECT_THROUGHPUT_GE(thresholds, name, op, options)            \
+  EXPECT_TRUE(perf_assert::CheckThroughput(                            \
+      (thresholds), (name), perf_assert::MeasureThroughput((op), (options))))
+
+/*
+ * EXPECT_LATENCY_P99_LE -- measures 99th percentile latency of op
+ * (microseconds) and expects it not to exceed threshold of given name from
+ * thresholds.
+ */
+#define EXPECT_LATENCY_P99_LE(thresholds, name, op, options)           \
+  EXPECT_TRUE(perf_assert::CheckLatencyP99(                            \
+      (thresholds), (name), perf_assert::MeasureLatencyP99((op), (options))))
+
+#endif  // !PMDK_TESTS_SRC_UTILS_TEST_UTILS_PERF_ASSERT_H_
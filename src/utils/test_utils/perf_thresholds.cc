@@ -0,0 +1,79 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "perf_thresholds.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+bool PerfThresholds::Get(const std::string &name, double &value) const {
+  auto it = thresholds_.find(name);
+
+  if (it == thresholds_.end()) {
+    return false;
+  }
+
+  value = it->second;
+  return true;
+}
+
+int PerfThresholds::LoadBaselineFile(const std::string &path) {
+  std::ifstream file(path);
+
+  if (!file.is_open()) {
+    std::cerr << "Cannot open baseline file: " << path << std::endl;
+    return -1;
+  }
+
+  std::string line;
+  unsigned line_number = 0;
+  while (std::getline(file, line)) {
+    ++line_number;
+    std::istringstream stream(line);
+    std::string name;
+    double value;
+
+    if (!(stream >> name) || name[0] == '#') {
+      continue;
+    }
+
+    if (!(stream >> value)) {
+      std::cerr << "Invalid threshold in " << path << ":" << line_number
+                << std::endl;
+      return -1;
+    }
+
+    thresholds_.insert({name, value});
+  }
+
+  return 0;
+}
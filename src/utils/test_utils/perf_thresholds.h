@@ -0,0 +1,78 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_TEST_UTILS_PERF_THRESHOLDS_H_
+#define PMDK_TESTS_SRC_UTILS_TEST_UTILS_PERF_THRESHOLDS_H_
+
+#include <map>
+#include <string>
+
+/*
+ * PerfThresholds -- named thresholds of performance gates (e.g. minimal
+ * throughput in Mops/s or maximal latency in microseconds) along with
+ * relative tolerance for measurement noise.
+ */
+class PerfThresholds final {
+ private:
+  std::map<std::string, double> thresholds_;
+  double tolerance_ = 0.05;
+
+ public:
+  void Set(const std::string &name, double value) {
+    thresholds_[name] = value;
+  }
+
+  /*
+   * Get -- assigns threshold of given name to value. Returns false if the
+   * threshold is not defined.
+   */
+  bool Get(const std::string &name, double &value) const;
+
+  double GetTolerance() const {
+    return tolerance_;
+  }
+
+  void SetTolerance(double tolerance) {
+    tolerance_ = tolerance;
+  }
+
+  /*
+   * LoadBaselineFile -- reads thresholds from baseline file, where each line
+   * consists of threshold name and value separated by whitespace. Empty lines
+   * and lines starting with '#' are skipped. Already defined thresholds are
+   * not overwritten. Returns 0 on success, prints error message and returns -1
+   * otherwise.
+   */
+  int LoadBaselineFile(const std::string &path);
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_TEST_UTILS_PERF_THRESHOLDS_H_
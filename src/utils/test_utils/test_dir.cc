@@ -0,0 +1,113 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_dir.h"
+#include <atomic>
+#include <iostream>
+#include <vector>
+#include "api_c/api_c.h"
+
+namespace test_utils {
+int CreateTestDir(const std::string &base, const std::string &test_name,
+                  std::string &test_dir) {
+  static std::atomic<unsigned> counter{0};
+
+  std::string name;
+  name.reserve(test_name.size());
+  for (char c : test_name) {
+    bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                   (c >= '0' && c <= '9') || c == '_' || c == '-' || c == '.';
+    name += allowed ? c : '_';
+  }
+
+  /* base directory is removed by the last test process which used it */
+  if (!ApiC::DirectoryExists(base) && ApiC::CreateDirectoryT(base) != 0 &&
+      !ApiC::DirectoryExists(base)) {
+    std::cerr << "Cannot create test directory: " << base << std::endl;
+    return -1;
+  }
+
+  std::string path = base + name + "_" +
+                     std::to_string(ApiC::GetProcessIdT()) + "_" +
+                     std::to_string(counter++);
+
+  /* left behind by crashed process which had the same identifier */
+  if (ApiC::DirectoryExists(path) && RemoveTestDir(path + SEPARATOR) != 0) {
+    std::cerr << "Cannot remove stale test directory: " << path << std::endl;
+    return -1;
+  }
+
+  if (ApiC::CreateDirectoryT(path) != 0) {
+    std::cerr << "Cannot create test directory: " << path << std::endl;
+    return -1;
+  }
+
+  test_dir = path + SEPARATOR;
+
+  return 0;
+}
+
+int RemoveTestDir(const std::string &test_dir) {
+  if (!ApiC::DirectoryExists(test_dir)) {
+    return 0;
+  }
+
+  if (ApiC::CleanDirectory(test_dir) != 0) {
+    return -1;
+  }
+
+  return ApiC::RemoveDirectoryT(test_dir);
+}
+
+std::string GetProcessDir(const std::string &base, const std::string &prefix) {
+  return GetProcessDir(base, prefix, ApiC::GetProcessIdT());
+}
+
+std::string GetProcessDir(const std::string &base, const std::string &prefix,
+                          unsigned long pid) {
+  return base + prefix + "_" + std::to_string(pid) + SEPARATOR;
+}
+
+int RemoveDirectoryIfEmpty(const std::string &dir) {
+  std::vector<std::string> entries;
+
+  if (ApiC::ListDirectory(dir, entries) != 0) {
+    return -1;
+  }
+
+  if (!entries.empty()) {
+    return 0;
+  }
+
+  return ApiC::RemoveDirectoryT(dir);
+}
+}  // namespace test_utils
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_TEST_UTILS_TEST_DIR_H_
+#define PMDK_TESTS_SRC_UTILS_TEST_UTILS_TEST_DIR_H_
+
+#include <string>
+
+namespace test_utils {
+/*
+ * CreateTestDir -- creates directory used by single test instance inside base
+ * directory. Directory name is derived from test_name, with characters that
+ * are not allowed in file names replaced, and suffixed with identifier of the
+ * calling process and counter unique within the process, so test instances
+ * never share files and may run concurrently. Stale directory with the same
+ * name is removed first. Assigns path ending with SEPARATOR to test_dir.
+ * Returns 0 on success, prints error message and returns -1 otherwise.
+ */
+int CreateTestDir(const std::string &base, const std::string &test_name,
+                  std::string &test_dir);
+
+/*
+ * RemoveTestDir -- removes directory created by CreateTestDir along with its
+ * content. Returns 0 on success, prints error message and returns -1
+ * otherwise.
+ */
+int RemoveTestDir(const std::string &test_dir);
+
+/*
+ * GetProcessDir -- returns path of directory named after prefix and identifier
+ * of the calling process inside base directory, ending with SEPARATOR.
+ * Intended for resources shared by tests of single process (e.g. pool image
+ * cache), which must not collide with other test processes using the same
+ * base directory. Directory is not created.
+ */
+std::string GetProcessDir(const std::string &base, const std::string &prefix);
+
+/*
+ * GetProcessDir -- returns path of directory which GetProcessDir called by
+ * process of given identifier returns, e.g. to remove resources left behind by
+ * crashed child process.
+ */
+std::string GetProcessDir(const std::string &base, const std::string &prefix,
+                          unsigned long pid);
+
+/*
+ * RemoveDirectoryIfEmpty -- removes given directory unless it still contains
+ * entries, e.g. created by other test processes running concurrently. Returns
+ * 0 on success or if directory is not empty, prints error message and returns
+ * -1 otherwise.
+ */
+int RemoveDirectoryIfEmpty(const std::string &dir);
+}  // namespace test_utils
+
+#endif  // !PMDK_TESTS_SRC_UTILS_TEST_UTILS_TEST_DIR_H_
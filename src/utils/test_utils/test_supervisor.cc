@@ -0,0 +1,499 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_supervisor.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include "timing_listener.h"
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace {
+/* filter matching names of disabled test cases and tests, as in gtest */
+const std::string DISABLED_FILTER = "DISABLED_*:*/DISABLED_*";
+
+bool MatchesPattern(const std::string &name, const std::string &pattern) {
+  size_t n = 0;
+  size_t p = 0;
+  size_t star = std::string::npos;
+  size_t mark = 0;
+
+  while (n < name.size()) {
+    if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+      ++n;
+      ++p;
+    } else if (p < pattern.size() && pattern[p] == '*') {
+      star = p++;
+      mark = n;
+    } else if (star != std::string::npos) {
+      p = star + 1;
+      n = ++mark;
+    } else {
+      return false;
+    }
+  }
+
+  while (p < pattern.size() && pattern[p] == '*') {
+    ++p;
+  }
+
+  return p == pattern.size();
+}
+
+bool MatchesAny(const std::string &name, const std::string &patterns) {
+  size_t begin = 0;
+
+  while (begin <= patterns.size()) {
+    size_t end = patterns.find(':', begin);
+    if (end == std::string::npos) {
+      end = patterns.size();
+    }
+    if (MatchesPattern(name, patterns.substr(begin, end - begin))) {
+      return true;
+    }
+    begin = end + 1;
+  }
+
+  return false;
+}
+
+std::string GetFullName(const ::testing::TestInfo &info) {
+  return std::string(info.test_case_name()) + "." + info.name();
+}
+
+#ifdef __linux__
+/*
+ * GetReportPath -- returns path of report file written by gtest as set by
+ * output flag. Returns empty string if no report is written or directory is
+ * given, in which gtest generates unique file names by itself.
+ */
+std::string GetReportPath() {
+  const std::string output = ::testing::GTEST_FLAG(output);
+  size_t colon = output.find(':');
+
+  if (colon == 0 || output.empty()) {
+    return "";
+  }
+
+  if (colon == std::string::npos) {
+    return "test_detail." + output;
+  }
+
+  std::string path = output.substr(colon + 1);
+  return path.empty() || path.back() == '/' ? "" : path;
+}
+
+/*
+ * GetChildReportPath -- returns report path with identifier of child process
+ * inserted before file extension.
+ */
+std::string GetChildReportPath(const std::string &report, unsigned long pid) {
+  size_t dot = report.rfind('.');
+  size_t slash = report.rfind('/');
+
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+    dot = report.size();
+  }
+
+  return report.substr(0, dot) + "_" + std::to_string(pid) +
+         report.substr(dot);
+}
+
+/* prefix of records with timings forwarded by TimingListener */
+const std::string TIMING_RECORD = "timing ";
+
+/*
+ * WriteRecord -- writes single line record to the pipe read by supervisor.
+ * Only one child writes to the pipe at a time, so records are not interleaved.
+ */
+void WriteRecord(int fd, const std::string &record) {
+  size_t written = 0;
+  while (written < record.size()) {
+    ssize_t ret = write(fd, record.c_str() + written, record.size() - written);
+    if (ret == -1 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      return;
+    }
+    written += static_cast<size_t>(ret);
+  }
+}
+
+/*
+ * ResultPipeListener -- writes result of every test run by child process to
+ * the pipe read by supervisor.
+ */
+class ResultPipeListener final : public ::testing::EmptyTestEventListener {
+ private:
+  int fd_;
+
+ public:
+  explicit ResultPipeListener(int fd) : fd_(fd) {
+  }
+
+  void OnTestEnd(const ::testing::TestInfo &info) override {
+    WriteRecord(fd_, GetFullName(info) + " " +
+                         (info.result()->Passed() ? "1 " : "0 ") +
+                         std::to_string(info.result()->elapsed_time()) + "\n");
+  }
+};
+#endif  // __linux__
+}  // namespace
+
+bool TestSupervisor::MatchesFilter(const std::string &name,
+                                   const std::string &filter) {
+  size_t dash = filter.find('-');
+  std::string positive = filter.substr(0, dash);
+  std::string negative =
+      dash == std::string::npos ? "" : filter.substr(dash + 1);
+
+  if (positive.empty()) {
+    positive = "*";
+  }
+
+  return MatchesAny(name, positive) && !MatchesAny(name, negative);
+}
+
+int TestSupervisor::ParseArguments(int &argc, char **argv) {
+  int i = 1;
+
+  while (i < argc) {
+    std::string arg = argv[i];
+    if (arg == "--fork") {
+      batch_size_ = 1;
+    } else if (arg.compare(0, 7, "--fork=") == 0) {
+      char *end = nullptr;
+      unsigned long size = std::strtoul(arg.c_str() + 7, &end, 10);
+      if (*end != '\0' || size == 0) {
+        std::cerr << "Invalid number of tests per child process: " << arg
+                  << std::endl;
+        return -1;
+      }
+      batch_size_ = static_cast<unsigned>(size);
+    } else if (arg.compare(0, 15, "--fork_timeout=") == 0) {
+      char *end = nullptr;
+      unsigned long timeout = std::strtoul(arg.c_str() + 15, &end, 10);
+      if (*end != '\0' || timeout == 0 || timeout > 24 * 3600) {
+        std::cerr << "Invalid timeout of child process: " << arg << std::endl;
+        return -1;
+      }
+      timeout_s_ = static_cast<unsigned>(timeout);
+    } else {
+      ++i;
+      continue;
+    }
+
+    for (int j = i; j < argc - 1; ++j) {
+      argv[j] = argv[j + 1];
+    }
+    --argc;
+  }
+
+  if (timeout_s_ > 0 && !IsEnabled()) {
+    std::cerr << "Timeout of child process requires --fork" << std::endl;
+    return -1;
+  }
+
+#ifndef __linux__
+  if (IsEnabled()) {
+    std::cerr << "Running tests in child processes is supported on Linux only"
+              << std::endl;
+    return -1;
+  }
+#endif
+
+  return 0;
+}
+
+int TestSupervisor::Run() {
+  if (!IsEnabled()) {
+    return RUN_ALL_TESTS();
+  }
+
+  const ::testing::UnitTest *unit_test = ::testing::UnitTest::GetInstance();
+  const std::string filter = ::testing::GTEST_FLAG(filter);
+  const bool run_disabled = ::testing::GTEST_FLAG(also_run_disabled_tests);
+
+  for (int i = 0; i < unit_test->total_test_case_count(); ++i) {
+    const ::testing::TestCase *test_case = unit_test->GetTestCase(i);
+    for (int j = 0; j < test_case->total_test_count(); ++j) {
+      const ::testing::TestInfo *info = test_case->GetTestInfo(j);
+      bool disabled = MatchesFilter(info->test_case_name(), DISABLED_FILTER) ||
+                      MatchesFilter(info->name(), DISABLED_FILTER);
+      std::string name = GetFullName(*info);
+      if ((disabled && !run_disabled) || !MatchesFilter(name, filter)) {
+        continue;
+      }
+      results_.emplace_back();
+      results_.back().name = name;
+    }
+  }
+
+  return Supervise();
+}
+
+#ifdef __linux__
+int TestSupervisor::Supervise() {
+  size_t next = 0;
+  unsigned children = 0;
+
+  /* report left by previous run would be taken for report of crashed child */
+  std::string report = GetReportPath();
+  if (!report.empty()) {
+    std::remove(report.c_str());
+  }
+
+  while (next < results_.size()) {
+    size_t count = std::min(static_cast<size_t>(batch_size_),
+                            results_.size() - next);
+    bool is_child = false;
+    int ret = RunBatch(next, count, next, is_child);
+    if (is_child) {
+      return ret;
+    }
+    if (ret != 0) {
+      return -1;
+    }
+    ++children;
+  }
+
+  PrintSummary(children);
+  TimingListener::Report();
+
+  for (const auto &result : results_) {
+    if (!result.passed) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+int TestSupervisor::RunBatch(size_t first, size_t count, size_t &next,
+                             bool &is_child) {
+  /* processes spawned by tests must not hold the pipe open */
+  int fds[2];
+  if (pipe2(fds, O_CLOEXEC) != 0) {
+    std::cerr << "pipe2 failed: " << strerror(errno) << std::endl;
+    return -1;
+  }
+
+  /* buffered output would be printed again by the child */
+  std::cout.flush();
+  std::cerr.flush();
+  fflush(stdout);
+  fflush(stderr);
+
+  pid_t pid = fork();
+  if (pid == -1) {
+    std::cerr << "fork failed: " << strerror(errno) << std::endl;
+    close(fds[0]);
+    close(fds[1]);
+    return -1;
+  }
+
+  if (pid == 0) {
+    close(fds[0]);
+    std::string batch_filter;
+    for (size_t i = first; i < first + count; ++i) {
+      batch_filter += results_[i].name + ":";
+    }
+    ::testing::GTEST_FLAG(filter) = batch_filter;
+    ::testing::UnitTest::GetInstance()->listeners().Append(
+        new ResultPipeListener(fds[1]));
+    int fd = fds[1];
+    TimingListener::Forward([fd](const std::string &record) {
+      WriteRecord(fd, TIMING_RECORD + record + "\n");
+    });
+    is_child = true;
+    if (child_setup_ && child_setup_() != 0) {
+      return -1;
+    }
+    return RUN_ALL_TESTS();
+  }
+
+  close(fds[1]);
+  std::string records;
+  char buf[4096];
+  bool timed_out = false;
+  for (;;) {
+    /* every finished test writes a record, so timeout applies to single test */
+    if (timeout_s_ > 0) {
+      pollfd pfd = {fds[0], POLLIN, 0};
+      int ready = poll(&pfd, 1, static_cast<int>(timeout_s_ * 1000));
+      if (ready == -1 && errno == EINTR) {
+        continue;
+      }
+      if (ready == 0) {
+        kill(pid, SIGKILL);
+        timed_out = true;
+        break;
+      }
+    }
+    ssize_t ret = read(fds[0], buf, sizeof(buf));
+    if (ret == -1 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      break;
+    }
+    records.append(buf, static_cast<size_t>(ret));
+  }
+  close(fds[0]);
+
+  int status = 0;
+  while (waitpid(pid, &status, 0) == -1) {
+    if (errno != EINTR) {
+      std::cerr << "waitpid failed: " << strerror(errno) << std::endl;
+      return -1;
+    }
+  }
+
+  /* every child writes report to the same path, which gtest set up before
+   * forking, so the report is moved aside before the next child overwrites it;
+   * crashed child leaves no report */
+  std::string report = GetReportPath();
+  if (!report.empty()) {
+    std::string child_report =
+        GetChildReportPath(report, static_cast<unsigned long>(pid));
+    if (std::rename(report.c_str(), child_report.c_str()) == 0) {
+      std::cout << "Report of child process written to " << child_report
+                << std::endl;
+    } else if (errno != ENOENT) {
+      std::cerr << "Cannot move report " << report << ": " << strerror(errno)
+                << std::endl;
+    }
+  }
+
+  std::istringstream stream(records);
+  std::string line;
+  while (std::getline(stream, line)) {
+    if (line.compare(0, TIMING_RECORD.size(), TIMING_RECORD) == 0) {
+      TimingListener::AddForwarded(line.substr(TIMING_RECORD.size()));
+      continue;
+    }
+    std::istringstream result(line);
+    std::string name;
+    int passed = 0;
+    long long elapsed_ms = 0;
+    if (!(result >> name >> passed >> elapsed_ms)) {
+      continue;
+    }
+    for (size_t i = first; i < first + count; ++i) {
+      if (results_[i].name == name) {
+        results_[i].finished = true;
+        results_[i].passed = passed == 1;
+        results_[i].elapsed_ms = elapsed_ms;
+      }
+    }
+  }
+
+  /* tests are run in registration order, so the first unfinished test is the
+   * one which ended the child, the rest of the batch goes to the next child */
+  next = first + count;
+  for (size_t i = first; i < first + count; ++i) {
+    if (results_[i].finished) {
+      continue;
+    }
+    results_[i].finished = true;
+    if (timed_out) {
+      results_[i].crash =
+          "timed out after " + std::to_string(timeout_s_) + " s";
+    } else if (WIFSIGNALED(status)) {
+      results_[i].crash =
+          "killed by signal " + std::to_string(WTERMSIG(status));
+    } else {
+      results_[i].crash =
+          "exited with code " + std::to_string(WEXITSTATUS(status));
+    }
+    std::cout << "[  FAILED  ] " << results_[i].name << " ("
+              << results_[i].crash << ")" << std::endl;
+    next = i + 1;
+    if (child_cleanup_) {
+      child_cleanup_(static_cast<unsigned long>(pid));
+    }
+    break;
+  }
+
+  return 0;
+}
+#else
+int TestSupervisor::Supervise() {
+  return RUN_ALL_TESTS();
+}
+
+int TestSupervisor::RunBatch(size_t, size_t, size_t &, bool &) {
+  return -1;
+}
+#endif  // __linux__
+
+void TestSupervisor::PrintSummary(unsigned children) const {
+  size_t passed = 0;
+  long long elapsed_ms = 0;
+  for (const auto &result : results_) {
+    passed += result.passed ? 1 : 0;
+    elapsed_ms += result.elapsed_ms;
+  }
+
+  std::cout << "[==========] " << results_.size() << " tests ran in "
+            << children << " child processes. (" << elapsed_ms
+            << " ms total)" << std::endl;
+  std::cout << "[  PASSED  ] " << passed << " tests." << std::endl;
+
+  if (passed == results_.size()) {
+    return;
+  }
+
+  std::cout << "[  FAILED  ] " << results_.size() - passed
+            << " tests, listed below:" << std::endl;
+  for (const auto &result : results_) {
+    if (result.passed) {
+      continue;
+    }
+    std::cout << "[  FAILED  ] " << result.name;
+    if (!result.crash.empty()) {
+      std::cout << ", " << result.crash;
+    }
+    std::cout << std::endl;
+  }
+}
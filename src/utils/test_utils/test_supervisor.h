@@ -0,0 +1,124 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_TEST_UTILS_TEST_SUPERVISOR_H_
+#define PMDK_TESTS_SRC_UTILS_TEST_UTILS_TEST_SUPERVISOR_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "non_copyable/non_copyable.h"
+
+/*
+ * TestSupervisor -- runs tests of gtest binary in child processes forked from
+ * the supervising process, which already read configuration and loaded
+ * libraries. Each child runs a batch of tests and reports their results to
+ * the supervisor over a pipe. Crash of a child fails only the test it was
+ * running, remaining tests of the batch are run in the next child. Supported
+ * on Linux only.
+ *
+ * Children inherit state created by the supervisor before forking. Resources
+ * which tests of a child modify (e.g. pool files) have to be created anew by
+ * child setup function and removed by child cleanup function if the child
+ * crashed before removing them itself.
+ */
+class TestSupervisor final : NonCopyable {
+ private:
+  struct TestResult {
+    std::string name;
+    bool finished = false;
+    bool passed = false;
+    long long elapsed_ms = 0;
+    std::string crash;
+  };
+
+  unsigned batch_size_ = 0;
+  unsigned timeout_s_ = 0;
+  std::vector<TestResult> results_;
+  std::function<int()> child_setup_;
+  std::function<void(unsigned long)> child_cleanup_;
+
+  int Supervise();
+  int RunBatch(size_t first, size_t count, size_t &next, bool &is_child);
+  void PrintSummary(unsigned children) const;
+
+ public:
+  /*
+   * ParseArguments -- consumes '--fork[=N]' argument, which enables running
+   * every N tests (1 by default) in separate child process, and
+   * '--fork_timeout=SECONDS' argument, which makes supervisor kill child that
+   * did not finish a test for given time (no limit by default). Has to be
+   * called after ::testing::InitGoogleTest. Returns 0 on success, prints error
+   * message and returns -1 otherwise.
+   */
+  int ParseArguments(int &argc, char **argv);
+
+  bool IsEnabled() const {
+    return batch_size_ > 0;
+  }
+
+  /*
+   * SetChildSetup -- sets function called in every forked child before its
+   * tests are run. Child whose setup function returns non-zero value runs no
+   * tests.
+   */
+  void SetChildSetup(const std::function<int()> &setup) {
+    child_setup_ = setup;
+  }
+
+  /*
+   * SetChildCleanup -- sets function called in the supervisor with identifier
+   * of child process which ended before running all tests of its batch.
+   */
+  void SetChildCleanup(const std::function<void(unsigned long)> &cleanup) {
+    child_cleanup_ = cleanup;
+  }
+
+  /*
+   * Run -- runs tests selected by gtest filter. If forking is disabled tests
+   * are run in the calling process. Otherwise returns in every forked child
+   * after its batch of tests is run, so that the caller performs the same
+   * cleanup as after regular run, and in the supervisor after all tests are
+   * run. Returns 0 if all tests passed, non-zero value otherwise.
+   */
+  int Run();
+
+  /*
+   * MatchesFilter -- checks that test of given full name (TestCase.Test) is
+   * selected by gtest filter (positive and negative patterns with '*' and '?'
+   * wildcards).
+   */
+  static bool MatchesFilter(const std::string &name, const std::string &filter);
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_TEST_UTILS_TEST_SUPERVISOR_H_
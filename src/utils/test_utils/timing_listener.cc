@@ -0,0 +1,333 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "timing_listener.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "api_c/api_c.h"
+#include "string_utils.h"
+
+namespace {
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+}  // namespace
+
+TimingListener *TimingListener::installed_ = nullptr;
+
+int TimingListener::Install(int &argc, char **argv) {
+  TimingListener *listener = new TimingListener();
+
+  if (listener->ParseArguments(argc, argv) != 0) {
+    delete listener;
+    return -1;
+  }
+
+  /* gtest takes ownership of the listener */
+  ::testing::UnitTest::GetInstance()->listeners().Append(listener);
+  installed_ = listener;
+
+  return 0;
+}
+
+TimingListener::~TimingListener() {
+  if (installed_ == this) {
+    installed_ = nullptr;
+  }
+}
+
+int TimingListener::ParseArguments(int &argc, char **argv) {
+  const std::string top_arg = "--timing_top=";
+  const std::string file_arg = "--timing_file=";
+  int i = 1;
+
+  while (i < argc) {
+    std::string arg = argv[i];
+    if (arg.compare(0, top_arg.size(), top_arg) == 0) {
+      char *end = nullptr;
+      unsigned long count =
+          std::strtoul(arg.c_str() + top_arg.size(), &end, 10);
+      if (end == arg.c_str() + top_arg.size() || *end != '\0') {
+        std::cerr << "Invalid number of the slowest tests: " << arg
+                  << std::endl;
+        return -1;
+      }
+      top_count_ = static_cast<unsigned>(count);
+    } else if (arg.compare(0, file_arg.size(), file_arg) == 0) {
+      file_path_ = arg.substr(file_arg.size());
+    } else {
+      ++i;
+      continue;
+    }
+
+    for (int j = i; j < argc - 1; ++j) {
+      argv[j] = argv[j + 1];
+    }
+    --argc;
+  }
+
+  return 0;
+}
+
+unsigned TimingListener::BeginStep(const std::string &name) {
+  if (installed_ == nullptr || !installed_->in_test_) {
+    return 0;
+  }
+
+  TimingListener &listener = *installed_;
+  listener.EndStep();
+
+  Timing step;
+  step.name = name;
+  listener.timings_.back().steps.emplace_back(step);
+  listener.in_step_ = true;
+  listener.step_start_ = Clock::now();
+  listener.step_cpu_start_ = ApiC::GetProcessCpuTime();
+
+  return ++listener.step_id_;
+}
+
+void TimingListener::EndStep(unsigned id) {
+  if (installed_ != nullptr && id != 0 && id == installed_->step_id_) {
+    installed_->EndStep();
+  }
+}
+
+void TimingListener::EndStep() {
+  if (!in_step_) {
+    return;
+  }
+
+  Timing &step = timings_.back().steps.back();
+  step.wall_s = SecondsSince(step_start_);
+  step.cpu_s = ApiC::GetProcessCpuTime() - step_cpu_start_;
+  in_step_ = false;
+}
+
+void TimingListener::OnTestStart(const ::testing::TestInfo &test_info) {
+  TestTiming timing;
+  timing.name =
+      std::string(test_info.test_case_name()) + "." + test_info.name();
+  if (test_info.value_param() != nullptr) {
+    timing.param = test_info.value_param();
+  } else if (test_info.type_param() != nullptr) {
+    timing.param = test_info.type_param();
+  }
+  timings_.emplace_back(timing);
+
+  in_test_ = true;
+  test_start_ = Clock::now();
+  test_cpu_start_ = ApiC::GetProcessCpuTime();
+}
+
+void TimingListener::OnTestEnd(const ::testing::TestInfo &test_info) {
+  EndStep();
+
+  TestTiming &timing = timings_.back();
+  timing.wall_s = SecondsSince(test_start_);
+  timing.cpu_s = ApiC::GetProcessCpuTime() - test_cpu_start_;
+  timing.passed = test_info.result()->Passed();
+  in_test_ = false;
+
+  if (forward_) {
+    forward_(Serialize(timing));
+  }
+}
+
+void TimingListener::OnTestProgramEnd(const ::testing::UnitTest &) {
+  /* supervisor reports timings of all child processes */
+  if (forward_) {
+    return;
+  }
+
+  if (top_count_ > 0 && !timings_.empty()) {
+    PrintSlowest();
+  }
+
+  if (!file_path_.empty()) {
+    WriteFile();
+  }
+}
+
+void TimingListener::Forward(
+    const std::function<void(const std::string &)> &forward) {
+  if (installed_ != nullptr) {
+    installed_->forward_ = forward;
+  }
+}
+
+int TimingListener::AddForwarded(const std::string &record) {
+  if (installed_ == nullptr) {
+    return 0;
+  }
+
+  TestTiming timing;
+  if (Deserialize(record, timing) != 0) {
+    std::cerr << "Invalid timing record: " << record << std::endl;
+    return -1;
+  }
+
+  installed_->timings_.emplace_back(timing);
+  return 0;
+}
+
+void TimingListener::Report() {
+  if (installed_ != nullptr) {
+    installed_->OnTestProgramEnd(*::testing::UnitTest::GetInstance());
+  }
+}
+
+std::string TimingListener::Serialize(const TestTiming &timing) {
+  /* fields are separated by tabs, which names must not contain */
+  auto field = [](std::string value) {
+    std::replace_if(value.begin(), value.end(),
+                    [](char c) { return c == '\t' || c == '\n'; }, ' ');
+    return value;
+  };
+
+  std::ostringstream record;
+  record << std::setprecision(9) << field(timing.name) << '\t'
+         << field(timing.param) << '\t' << (timing.passed ? 1 : 0) << '\t'
+         << timing.wall_s << '\t' << timing.cpu_s;
+  for (const auto &step : timing.steps) {
+    record << '\t' << field(step.name) << '\t' << step.wall_s << '\t'
+           << step.cpu_s;
+  }
+
+  return record.str();
+}
+
+int TimingListener::Deserialize(const std::string &record,
+                                TestTiming &timing) {
+  std::vector<std::string> fields;
+  std::istringstream stream(record);
+  std::string field;
+  while (std::getline(stream, field, '\t')) {
+    fields.emplace_back(field);
+  }
+
+  if (fields.size() < 5 || (fields.size() - 5) % 3 != 0) {
+    return -1;
+  }
+
+  try {
+    timing.name = fields[0];
+    timing.param = fields[1];
+    timing.passed = fields[2] == "1";
+    timing.wall_s = std::stod(fields[3]);
+    timing.cpu_s = std::stod(fields[4]);
+    for (size_t i = 5; i < fields.size(); i += 3) {
+      Timing step;
+      step.name = fields[i];
+      step.wall_s = std::stod(fields[i + 1]);
+      step.cpu_s = std::stod(fields[i + 2]);
+      timing.steps.emplace_back(step);
+    }
+  } catch (const std::logic_error &) {
+    return -1;
+  }
+
+  return 0;
+}
+
+void TimingListener::PrintSlowest() const {
+  std::vector<const TestTiming *> sorted;
+  for (const auto &timing : timings_) {
+    sorted.emplace_back(&timing);
+  }
+
+  size_t count = std::min(static_cast<size_t>(top_count_), sorted.size());
+  std::partial_sort(sorted.begin(), sorted.begin() + count, sorted.end(),
+                    [](const TestTiming *a, const TestTiming *b) {
+                      return a->wall_s > b->wall_s;
+                    });
+
+  std::cout << "[  TIMING  ] " << count << " slowest of " << timings_.size()
+            << " tests (wall s / CPU s):" << std::endl;
+  std::ios_base::fmtflags flags = std::cout.flags();
+  std::streamsize precision = std::cout.precision();
+  std::cout << std::fixed << std::setprecision(3);
+  for (size_t i = 0; i < count; ++i) {
+    std::cout << "[  TIMING  ] " << std::setw(10) << sorted[i]->wall_s << " "
+              << std::setw(10) << sorted[i]->cpu_s << " " << sorted[i]->name
+              << std::endl;
+    for (const auto &step : sorted[i]->steps) {
+      std::cout << "[  TIMING  ] " << std::setw(10) << step.wall_s << " "
+                << std::setw(10) << step.cpu_s << "   " << step.name
+                << std::endl;
+    }
+  }
+  std::cout.flags(flags);
+  std::cout.precision(precision);
+}
+
+int TimingListener::WriteFile() const {
+  /* processes running tests of the same binary (e.g. shards) may append to
+   * the same file, each line is complete record of single test */
+  std::ofstream file(file_path_, std::ios_base::app);
+  if (!file.is_open()) {
+    std::cerr << "Cannot open timing file: " << file_path_ << std::endl;
+    return -1;
+  }
+
+  for (const auto &timing : timings_) {
+    std::ostringstream line;
+    line << std::setprecision(6) << "{\"name\":\""
+         << string_utils::EscapeJson(timing.name) << "\",\"param\":\""
+         << string_utils::EscapeJson(timing.param)
+         << "\",\"passed\":" << (timing.passed ? "true" : "false")
+         << ",\"wall_s\":" << timing.wall_s << ",\"cpu_s\":" << timing.cpu_s
+         << ",\"steps\":[";
+    for (const auto &step : timing.steps) {
+      line << (&step == &timing.steps.front() ? "" : ",") << "{\"name\":\""
+           << string_utils::EscapeJson(step.name)
+           << "\",\"wall_s\":" << step.wall_s << ",\"cpu_s\":" << step.cpu_s
+           << "}";
+    }
+    line << "]}\n";
+    file << line.str() << std::flush;
+  }
+
+  if (!file.good()) {
+    std::cerr << "Cannot write timing file: " << file_path_ << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
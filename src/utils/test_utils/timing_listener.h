@@ -0,0 +1,163 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_TEST_UTILS_TIMING_LISTENER_H_
+#define PMDK_TESTS_SRC_UTILS_TEST_UTILS_TIMING_LISTENER_H_
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+/*
+ * TimingListener -- gtest event listener which measures wall and CPU time of
+ * every test (every parameter instance of parameterized tests) and of steps
+ * marked with ScopedStep. At the end of the run prints the slowest tests and
+ * optionally appends timings to machine-readable file, one JSON object per
+ * test and line, e.g.:
+ * {"name":"Case.Test/0","param":"...","passed":true,"wall_s":0.5,
+ *  "cpu_s":0.2,"steps":[{"name":"Step 1","wall_s":0.1,"cpu_s":0.1}]}
+ *
+ * When tests run in child processes (see TestSupervisor), listener of every
+ * child forwards timings of finished tests to the supervisor, which reports
+ * timings of all tests at the end.
+ */
+class TimingListener final : public ::testing::EmptyTestEventListener {
+ private:
+  struct Timing {
+    std::string name;
+    double wall_s = 0;
+    double cpu_s = 0;
+  };
+
+  struct TestTiming : Timing {
+    std::string param;
+    bool passed = false;
+    std::vector<Timing> steps;
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  static TimingListener *installed_;
+
+  unsigned top_count_ = 10;
+  std::string file_path_;
+  std::function<void(const std::string &)> forward_;
+  std::vector<TestTiming> timings_;
+  bool in_test_ = false;
+  Clock::time_point test_start_;
+  double test_cpu_start_ = 0;
+  bool in_step_ = false;
+  unsigned step_id_ = 0;
+  Clock::time_point step_start_;
+  double step_cpu_start_ = 0;
+
+  int ParseArguments(int &argc, char **argv);
+  void EndStep();
+  void PrintSlowest() const;
+  int WriteFile() const;
+  static std::string Serialize(const TestTiming &timing);
+  static int Deserialize(const std::string &record, TestTiming &timing);
+
+ public:
+  /*
+   * Install -- consumes '--timing_top=N' (number of the slowest tests
+   * reported, 10 by default, 0 disables the report) and '--timing_file=PATH'
+   * (file timings are appended to) arguments and appends listener to gtest
+   * listeners. Has to be called after ::testing::InitGoogleTest. Returns 0 on
+   * success, prints error message and returns -1 otherwise.
+   */
+  static int Install(int &argc, char **argv);
+
+  /*
+   * BeginStep -- ends current step of running test and begins new one with
+   * given name. Returns identifier of the step, 0 if listener is not
+   * installed or no test is running.
+   */
+  static unsigned BeginStep(const std::string &name);
+
+  /*
+   * EndStep -- ends step with given identifier unless it was already ended
+   * by the next step or by end of the test.
+   */
+  static void EndStep(unsigned id);
+
+  /*
+   * Forward -- makes listener of the calling process pass record of every
+   * finished test to given function instead of reporting timings at the end
+   * of the run. Intended for child processes running tests on behalf of the
+   * supervisor. Records are single lines.
+   */
+  static void Forward(const std::function<void(const std::string &)> &forward);
+
+  /*
+   * AddForwarded -- adds timing of test from record forwarded by child
+   * process. Returns 0 on success, prints error message and returns -1
+   * otherwise.
+   */
+  static int AddForwarded(const std::string &record);
+
+  /*
+   * Report -- prints the slowest tests and writes timing file as at the end of
+   * regular run. Intended for supervisor, which runs no tests itself.
+   */
+  static void Report();
+
+  void OnTestStart(const ::testing::TestInfo &test_info) override;
+  void OnTestEnd(const ::testing::TestInfo &test_info) override;
+  void OnTestProgramEnd(const ::testing::UnitTest &unit_test) override;
+  ~TimingListener();
+};
+
+/*
+ * ScopedStep -- marks step of the test measured by TimingListener. Step lasts
+ * until the object goes out of scope or the next step begins, so steps may be
+ * declared one after another in the same scope, e.g. ScopedStep step1("Step
+ * 1"); ... ScopedStep step2("Step 2");
+ */
+class ScopedStep final {
+ private:
+  unsigned id_;
+
+ public:
+  explicit ScopedStep(const std::string &name)
+      : id_(TimingListener::BeginStep(name)) {
+  }
+  ScopedStep(const ScopedStep &) = delete;
+  ScopedStep &operator=(const ScopedStep &) = delete;
+  ~ScopedStep() {
+    TimingListener::EndStep(id_);
+  }
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_TEST_UTILS_TIMING_LISTENER_H_
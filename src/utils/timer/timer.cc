@@ -0,0 +1,104 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "timer.h"
+#include <iostream>
+#if defined(PMDK_TESTS_TIMER_TSC) && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+
+bool Timer::use_tsc_ = false;
+double Timer::ns_per_tick_ = 1.0;
+
+namespace {
+bool HasInvariantTsc() {
+#ifdef PMDK_TESTS_TIMER_TSC
+  /* CPUID.80000007H:EDX[8] */
+  const unsigned leaf = 0x80000007;
+  const unsigned invariant_tsc = 1u << 8;
+#ifdef _MSC_VER
+  int regs[4];
+  __cpuid(regs, 0x80000000);
+  if (static_cast<unsigned>(regs[0]) < leaf) {
+    return false;
+  }
+  __cpuid(regs, leaf);
+  return (static_cast<unsigned>(regs[3]) & invariant_tsc) != 0;
+#else
+  unsigned eax, ebx, ecx, edx;
+  if (__get_cpuid_max(0x80000000, nullptr) < leaf ||
+      __get_cpuid(leaf, &eax, &ebx, &ecx, &edx) == 0) {
+    return false;
+  }
+  return (edx & invariant_tsc) != 0;
+#endif  // _MSC_VER
+#else
+  return false;
+#endif  // PMDK_TESTS_TIMER_TSC
+}
+}  // namespace
+
+int Timer::Calibrate() {
+  use_tsc_ = false;
+  ns_per_tick_ = 1.0;
+
+  if (!HasInvariantTsc()) {
+    std::cerr << "Invariant time stamp counter is not available, monotonic "
+                 "clock is used"
+              << std::endl;
+    return -1;
+  }
+
+#ifdef PMDK_TESTS_TIMER_TSC
+  /* 10 ms is enough for an error well below clock resolution impact */
+  const uint64_t calibration_ns = 10000000;
+  uint64_t start_ns = ReadClockNanoseconds();
+  uint64_t start_ticks = __rdtsc();
+  uint64_t end_ns;
+
+  do {
+    end_ns = ReadClockNanoseconds();
+  } while (end_ns - start_ns < calibration_ns);
+  uint64_t end_ticks = __rdtsc();
+
+  if (end_ticks <= start_ticks) {
+    std::cerr << "Time stamp counter does not advance, monotonic clock is used"
+              << std::endl;
+    return -1;
+  }
+
+  ns_per_tick_ = static_cast<double>(end_ns - start_ns) /
+                 static_cast<double>(end_ticks - start_ticks);
+  use_tsc_ = true;
+#endif  // PMDK_TESTS_TIMER_TSC
+  return 0;
+}
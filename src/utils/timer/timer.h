@@ -0,0 +1,122 @@
+/*
+ * Copyright 2018, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PMDK_TESTS_SRC_UTILS_TIMER_TIMER_H_
+#define PMDK_TESTS_SRC_UTILS_TIMER_TIMER_H_
+
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PMDK_TESTS_TIMER_TSC
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define PMDK_TESTS_TIMER_TSC
+#endif
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif  // _WIN32
+
+/*
+ * Timer -- low overhead timestamps for measuring single operations. Ticks
+ * come from time stamp counter if it is invariant and was calibrated with
+ * Calibrate(), from monotonic clock (in nanoseconds) otherwise.
+ */
+class Timer final {
+ private:
+  static bool use_tsc_;
+  static double ns_per_tick_;
+
+ public:
+  /*
+   * Calibrate -- measures frequency of time stamp counter against monotonic
+   * clock and switches ReadTicks() to it if it is invariant. Not thread
+   * safe, should be called once before measurements start. Returns 0 on
+   * success, -1 if monotonic clock is used instead.
+   */
+  static int Calibrate();
+
+  static bool IsTscUsed() {
+    return use_tsc_;
+  }
+
+  /*
+   * ReadTicks -- returns current timestamp in ticks. Previous instructions
+   * complete before the counter is read.
+   */
+  static uint64_t ReadTicks() {
+#ifdef PMDK_TESTS_TIMER_TSC
+    if (use_tsc_) {
+      _mm_lfence();
+      return __rdtsc();
+    }
+#endif  // PMDK_TESTS_TIMER_TSC
+    return ReadClockNanoseconds();
+  }
+
+  /*
+   * ReadClockNanoseconds -- returns monotonic clock reading in nanoseconds.
+   */
+  static uint64_t ReadClockNanoseconds() {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency = []() {
+      LARGE_INTEGER f;
+      QueryPerformanceFrequency(&f);
+      return f;
+    }();
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    uint64_t seconds = counter.QuadPart / frequency.QuadPart;
+    uint64_t rest = counter.QuadPart % frequency.QuadPart;
+    return seconds * 1000000000ULL + rest * 1000000000ULL / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+#endif  // _WIN32
+  }
+
+  static double ToNanoseconds(uint64_t ticks) {
+    return ticks * ns_per_tick_;
+  }
+
+  /*
+   * GetElapsedNanoseconds -- returns nanoseconds elapsed since timestamp
+   * returned by ReadTicks().
+   */
+  static uint64_t GetElapsedNanoseconds(uint64_t start_ticks) {
+    return static_cast<uint64_t>((ReadTicks() - start_ticks) * ns_per_tick_);
+  }
+};
+
+#endif  // !PMDK_TESTS_SRC_UTILS_TIMER_TIMER_H_